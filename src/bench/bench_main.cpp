@@ -0,0 +1,404 @@
+#include "../game/game_manager.h"
+#include "../game/battle_queue.h"
+#include "../game/world_file.h"
+#include "../utils/random.h"
+#include "../utils/proximity_kernel.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <iterator>
+#include <cstdio>
+#include <functional>
+
+//      (  GameManager)
+class GameBench {
+public:
+    static void initialize(GameManager& game) { game.initialize(); }
+    
+    static int collisionPass(GameManager& game, std::vector<BattleTask>& out) {
+        game.tick++;
+        game.rebuildGrid();
+        return game.detectCollisions(game.tick.load(), out);
+    }
+    
+    static void resolveBattle(GameManager& game, const BattleTask& task) {
+        game.resolveBattle(task.attacker.slot(), task.defender.slot(), task.tick);
+    }
+    
+    static const std::vector<std::shared_ptr<NPC>>& facades(GameManager& game) {
+        return game.npcFacades();
+    }
+    
+    static const World& world(GameManager& game) { return game.world; }
+    
+    static bool publishSnapshot(GameManager& game) {
+        return game.snapshots.publish(game.world, game.tick.load());
+    }
+    static void drawMap(GameManager& game, TerminalRenderer& renderer) {
+        renderer.beginFrame();
+        game.drawMap(*game.snapshots.read(), renderer);
+        renderer.compose();
+    }
+};
+
+namespace {
+
+struct BenchResult {
+    std::string name;
+    size_t npcs;
+    int threads;
+    std::string variant;
+    size_t iterations;
+    double ns_per_op;
+    double ops_per_sec;
+};
+
+//       GameManager
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+//  fn,    min_seconds; fn   
+template <typename Fn>
+BenchResult measure(const std::string& name, size_t npcs, int threads, 
+                    const std::string& variant, double min_seconds, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+    size_t operations = 0;
+    size_t iterations = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    
+    do {
+        operations += fn();
+        iterations++;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < min_seconds);
+    
+    double ns_per_op = operations > 0 ? elapsed * 1e9 / operations : 0.0;
+    double ops_per_sec = elapsed > 0.0 ? operations / elapsed : 0.0;
+    return {name, npcs, threads, variant, iterations, ns_per_op, ops_per_sec};
+}
+
+//   ,    : 50 NPC  100x100
+GameConfig worldConfig(size_t npcs) {
+    GameConfig config;
+    config.total_npcs = static_cast<int>(npcs);
+    config.map_width = std::max(100, static_cast<int>(std::sqrt(200.0 * npcs)));
+    config.map_height = config.map_width;
+    config.headless = true;
+    config.movement_threads = 1;
+    config.battle_threads = 1;
+    return config;
+}
+
+size_t queueRoundTrip(BattleQueue& queue, int threads, size_t tasks) {
+    std::atomic<size_t> consumed{0};
+    size_t per_producer = std::max<size_t>(1, tasks / threads);
+    size_t total = per_producer * threads;
+    
+    std::vector<std::thread> workers;
+    for (int c = 0; c < threads; ++c) {
+        workers.emplace_back([&]() {
+            std::vector<BattleTask> batch;
+            while (consumed.load() < total) {
+                size_t count = queue.popBatch(batch, 64, std::chrono::milliseconds(1));
+                consumed += count;
+            }
+        });
+    }
+    for (int p = 0; p < threads; ++p) {
+        workers.emplace_back([&queue, per_producer, p]() {
+            //  ,      
+            uint32_t base = static_cast<uint32_t>(p * per_producer);
+            for (size_t i = 0; i < per_producer; ++i) {
+                uint32_t attacker = base + static_cast<uint32_t>(i);
+                queue.push(BattleTask(NPCHandle::make(attacker, 0), NPCHandle::make(attacker + 1, 0)));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return total;
+}
+
+//       ,  
+//  ;   -  
+std::string checkWorldFile(const World& world, int width, int height, const std::string& path) {
+    WorldFile::save(world, width, height, path);
+    
+    World loaded;
+    int loaded_width = 0;
+    int loaded_height = 0;
+    WorldFile::load(path, loaded, loaded_width, loaded_height);
+    
+    if (loaded.size() != world.size() || loaded_width != width || loaded_height != height) {
+        return "world size differs after load";
+    }
+    for (uint32_t id = 0; id < world.size(); ++id) {
+        if (loaded.kind(id) != world.kind(id) || loaded.x(id) != world.x(id) || 
+            loaded.y(id) != world.y(id) || loaded.isAlive(id) != world.isAlive(id) ||
+            loaded.name(id) != world.name(id)) {
+            return "slot " + std::to_string(id) + " differs after load";
+        }
+    }
+    if (loaded.stats().aliveByKind() != world.stats().aliveByKind()) {
+        return "population counters differ after load";
+    }
+    
+    std::vector<char> original;
+    {
+        std::ifstream file(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    WorldFileHeader header;
+    std::memcpy(&header, original.data(), sizeof(header));
+    
+    //      ,     
+    auto rejects = [&](const std::function<void(std::vector<char>&)>& corrupt) {
+        std::vector<char> bytes = original;
+        corrupt(bytes);
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+        World broken;
+        int broken_width, broken_height;
+        try {
+            WorldFile::load(path, broken, broken_width, broken_height);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    
+    std::string error;
+    if (world.size() > 0 && !rejects([&](std::vector<char>& bytes) {
+            bytes[header.kinds_offset] = static_cast<char>(NPC_KIND_COUNT);
+        })) {
+        error = "unknown NPC kind accepted";
+    } else if (world.size() > 1 && !rejects([&](std::vector<char>& bytes) {
+            //       
+            char* offsets = bytes.data() + header.name_offsets_offset;
+            uint32_t end;
+            std::memcpy(&end, offsets + 2 * sizeof(uint32_t), sizeof(end));
+            end++;
+            std::memcpy(offsets + sizeof(uint32_t), &end, sizeof(end));
+        })) {
+        error = "non-monotonic name table accepted";
+    } else if (world.size() % 64 != 0 && !rejects([&](std::vector<char>& bytes) {
+            //     
+            char* last = bytes.data() + header.alive_offset + (world.size() / 64) * sizeof(uint64_t);
+            uint64_t word;
+            std::memcpy(&word, last, sizeof(word));
+            word |= uint64_t(1) << 63;
+            std::memcpy(last, &word, sizeof(word));
+        })) {
+        error = "alive bit past the last slot accepted";
+    } else if (!rejects([&](std::vector<char>& bytes) {
+            // ,      
+            WorldFileHeader broken = header;
+            broken.kinds_offset = ~uint64_t(0) - 7;
+            std::memcpy(bytes.data(), &broken, sizeof(broken));
+        })) {
+        error = "wrapping section offset accepted";
+    } else if (!rejects([&](std::vector<char>& bytes) {
+            WorldFileHeader broken = header;
+            broken.alive_offset += 1;
+            std::memcpy(bytes.data(), &broken, sizeof(broken));
+        })) {
+        error = "misaligned section accepted";
+    }
+    std::remove(path.c_str());
+    return error;
+}
+
+std::string toJson(const std::vector<BenchResult>& results, uint64_t seed) {
+    std::ostringstream out;
+    out << "{\n  \"seed\": " << seed 
+        << ",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+        << ",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"npcs\": " << r.npcs
+            << ", \"threads\": " << r.threads << ", \"variant\": \"" << r.variant << "\""
+            << ", \"iterations\": " << r.iterations 
+            << ", \"ns_per_op\": " << r.ns_per_op 
+            << ", \"ops_per_sec\": " << r.ops_per_sec << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t max_npcs = 1000000;
+    double min_seconds = 0.2;
+    uint64_t seed = 1;
+    std::string output_path;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-npcs" && i + 1 < argc) max_npcs = std::stoul(argv[++i]);
+        else if (arg == "--min-time" && i + 1 < argc) min_seconds = std::stod(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc) seed = std::stoull(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc) output_path = argv[++i];
+        else {
+            std::cerr << "Usage: balagur_bench [--max-npcs N] [--min-time S] [--seed N] [--out file.json]" 
+                      << std::endl;
+            return 1;
+        }
+    }
+    
+    Random::setSeed(seed);
+    std::vector<BenchResult> results;
+    
+    //  GameManager     ,    JSON
+    NullBuffer null_buffer;
+    std::streambuf* original_cout = std::cout.rdbuf(&null_buffer);
+    
+    for (size_t npcs : {size_t(1000), size_t(10000), size_t(100000), size_t(1000000)}) {
+        if (npcs > max_npcs) break;
+        std::cerr << "benchmarking " << npcs << " NPCs..." << std::endl;
+        
+        GameManager game(worldConfig(npcs));
+        GameBench::initialize(game);
+        
+        //        mmap
+        const std::string world_path = "balagur_bench_world.bin";
+        std::string world_error = checkWorldFile(GameBench::world(game), worldConfig(npcs).map_width, 
+                                                 worldConfig(npcs).map_width, world_path);
+        if (!world_error.empty()) {
+            std::cout.rdbuf(original_cout);
+            std::cerr << "world file self-check failed: " << world_error << std::endl;
+            return 1;
+        }
+        WorldFile::save(GameBench::world(game), worldConfig(npcs).map_width, worldConfig(npcs).map_width, world_path);
+        results.push_back(measure("world_load", npcs, 1, "mmap", min_seconds, [&]() {
+            World loaded;
+            int width, height;
+            WorldFile::load(world_path, loaded, width, height);
+            return loaded.size();
+        }));
+        std::remove(world_path.c_str());
+        
+        //    ( + )
+        std::vector<BattleTask> tasks;
+        results.push_back(measure("collision_pass", npcs, 1, "grid", min_seconds, [&]() {
+            GameBench::collisionPass(game, tasks);
+            return size_t(1);
+        }));
+        
+        //     NPC
+        const auto& facades = GameBench::facades(game);
+        volatile double sink = 0.0;
+        results.push_back(measure("calculate_distance", npcs, 1, "virtual", min_seconds, [&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i + 1 < facades.size(); ++i) {
+                sum += facades[i]->calculateDistance(facades[i + 1]);
+            }
+            sink = sink + sum;
+            return facades.size() - 1;
+        }));
+        
+        //   :     
+        //   3x3 ,     
+        const size_t block = 1024;
+        std::vector<int> block_xs(block), block_ys(block), block_reach(block, 100), block_out(block);
+        std::vector<uint32_t> block_hits(block);
+        for (size_t i = 0; i < block; ++i) {
+            block_xs[i] = Random::getInt(0, 30);
+            block_ys[i] = Random::getInt(0, 30);
+        }
+        SimdLevel best_level = ProximityKernel::detectLevel();
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+            if (static_cast<int>(level) > static_cast<int>(best_level)) break;
+            ProximityKernel::setLevel(level);
+            const char* variant = ProximityKernel::levelName(level);
+            
+            results.push_back(measure("squared_distances", npcs, 1, variant, min_seconds, [&]() {
+                for (int point = 0; point < 64; ++point) {
+                    ProximityKernel::squaredDistances(point % 30, point / 3, block_xs.data(), 
+                                                      block_ys.data(), block, block_out.data());
+                }
+                sink = sink + block_out[0];
+                return size_t(64) * block;
+            }));
+            results.push_back(measure("collect_in_reach", npcs, 1, variant, min_seconds, [&]() {
+                size_t found = 0;
+                for (int point = 0; point < 64; ++point) {
+                    found += ProximityKernel::collectInReach(point % 30, point / 3, 25, 
+                        block_xs.data(), block_ys.data(), block_reach.data(), block,
+                        block_hits.data(), block_out.data());
+                }
+                sink = sink + found;
+                return size_t(64) * block;
+            }));
+            results.push_back(measure("collision_pass", npcs, 1, variant, min_seconds, [&]() {
+                GameBench::collisionPass(game, tasks);
+                return size_t(1);
+            }));
+        }
+        ProximityKernel::setLevel(best_level);
+        
+        //      
+        results.push_back(measure("publish_snapshot", npcs, 1, "double-buffer", min_seconds, [&]() {
+            GameBench::publishSnapshot(game);
+            return npcs;
+        }));
+        
+        //   
+        TerminalRenderer renderer(-1);
+        results.push_back(measure("print_map", npcs, 1, "40x10", min_seconds, [&]() {
+            GameBench::drawMap(game, renderer);
+            return size_t(1);
+        }));
+        
+        //      
+        if (!tasks.empty()) {
+            results.push_back(measure("resolve_battle", npcs, 1, "dice+kill", min_seconds, [&]() {
+                for (const auto& task : tasks) {
+                    GameBench::resolveBattle(game, task);
+                }
+                return tasks.size();
+            }));
+        }
+        
+        //  : N   N 
+        for (auto backend : {BattleQueue::Backend::Mutex, BattleQueue::Backend::LockFree}) {
+            const char* variant = backend == BattleQueue::Backend::Mutex ? "mutex" : "lockfree";
+            BattleQueue queue(backend);
+            for (int threads : {1, 2, 4, 8, 16}) {
+                results.push_back(measure("battle_queue_push_pop", npcs, threads, variant, min_seconds, 
+                    [&]() { return queueRoundTrip(queue, threads, npcs); }));
+            }
+        }
+    }
+    
+    std::cout.rdbuf(original_cout);
+    
+    std::string json = toJson(results, seed);
+    if (output_path.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file(output_path);
+        if (!file) {
+            std::cerr << "Cannot open " << output_path << std::endl;
+            return 1;
+        }
+        file << json;
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -2,47 +2,77 @@
 #include "../npc/bear.h"
 #include "../npc/werewolf.h"
 #include "../npc/bandit.h"
+#include "../utils/random.h"
 #include <stdexcept>
+#include <array>
 
-std::random_device NPCFactory::rd;
-std::mt19937 NPCFactory::gen(NPCFactory::rd());
-
-std::shared_ptr<NPC> NPCFactory::createNPC(const std::string& type, 
+std::shared_ptr<NPC> NPCFactory::createNPC(World& world,
+                                          const std::string& type, 
                                           const std::string& name, 
                                           int x, int y) {
     if (x < 0 || y < 0) {
         throw std::invalid_argument("Coordinates must be non-negative");
     }
     
-    if (type == "Bear") {
-        return std::make_shared<Bear>(name, x, y);
-    } else if (type == "Werewolf") {
-        return std::make_shared<Werewolf>(name, x, y);
-    } else if (type == "Bandit") {
-        return std::make_shared<Bandit>(name, x, y);
+    NPCKind kind;
+    if (!kindFromName(type, kind)) {
+        throw std::invalid_argument("Unknown NPC type: " + type);
+    }
+    
+    return bindNPC(world, world.add(kind, name, x, y));
+}
+
+std::shared_ptr<NPC> NPCFactory::bindNPC(World& world, uint32_t id) {
+    switch (world.kind(id)) {
+        case NPCKind::Bear: return std::make_shared<Bear>(world, id);
+        case NPCKind::Werewolf: return std::make_shared<Werewolf>(world, id);
+        case NPCKind::Bandit: return std::make_shared<Bandit>(world, id);
     }
     
-    throw std::invalid_argument("Unknown NPC type: " + type);
+    throw std::invalid_argument("Unknown NPC kind");
 }
 
-std::shared_ptr<NPC> NPCFactory::createRandomNPC(const std::string& base_name, 
+std::shared_ptr<NPC> NPCFactory::createRandomNPC(World& world,
+                                                const std::string& base_name, 
                                                 int map_width, 
                                                 int map_height) {
-    std::string type = getRandomType();
+    uint32_t id = static_cast<uint32_t>(world.size());
+    NPCKind kind = static_cast<NPCKind>(
+        Random::keyedInt(0, NPC_KIND_COUNT - 1, 0, id, RandomPurpose::SpawnKind));
+    std::string type = kindName(kind);
     std::string name = type + "_" + base_name;
     
-    std::uniform_int_distribution<> x_dist(0, map_width - 1);
-    std::uniform_int_distribution<> y_dist(0, map_height - 1);
+    auto position = Random::block(0, id, RandomPurpose::SpawnPosition);
+    int x = Random::toRange(position[0], 0, map_width - 1);
+    int y = Random::toRange(position[1], 0, map_height - 1);
+    
+    return createNPC(world, type, name, x, y);
+}
+
+uint32_t NPCFactory::spawnRandomNPC(World& world, uint32_t number, 
+                                    int map_width, int map_height) {
+    //       
+    static const std::array<std::string, NPC_KIND_COUNT> prefixes = []() {
+        std::array<std::string, NPC_KIND_COUNT> result;
+        for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+            result[kind] = std::string(kindName(static_cast<NPCKind>(kind))) + "_NPC_";
+        }
+        return result;
+    }();
+    
+    uint32_t id = static_cast<uint32_t>(world.size());
+    NPCKind kind = static_cast<NPCKind>(
+        Random::keyedInt(0, NPC_KIND_COUNT - 1, 0, id, RandomPurpose::SpawnKind));
     
-    int x = x_dist(gen);
-    int y = y_dist(gen);
+    auto position = Random::block(0, id, RandomPurpose::SpawnPosition);
+    int x = Random::toRange(position[0], 0, map_width - 1);
+    int y = Random::toRange(position[1], 0, map_height - 1);
     
-    return createNPC(type, name, x, y);
+    return world.addNumbered(kind, prefixes[static_cast<int>(kind)], number, x, y);
 }
 
 std::string NPCFactory::getRandomType() {
-    std::uniform_int_distribution<> type_dist(0, 2);
-    int type_num = type_dist(gen);
+    int type_num = Random::getInt(0, 2);
     
     switch (type_num) {
         case 0: return "Bear";
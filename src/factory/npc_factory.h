@@ -2,24 +2,33 @@
 #define NPC_FACTORY_H
 
 #include "../npc/npc.h"
+#include "../game/world.h"
 #include <memory>
 #include <string>
-#include <random>
 
 class NPCFactory {
-private:
-    static std::random_device rd;
-    static std::mt19937 gen;
-    
 public:
-    static std::shared_ptr<NPC> createNPC(const std::string& type, 
+    //  NPC        
+    static std::shared_ptr<NPC> createNPC(World& world,
+                                         const std::string& type, 
                                          const std::string& name, 
                                          int x, int y);
     
-    static std::shared_ptr<NPC> createRandomNPC(const std::string& base_name, 
+    //       (0,  ), 
+    //       
+    static std::shared_ptr<NPC> createRandomNPC(World& world,
+                                               const std::string& base_name, 
                                                int map_width, 
                                                int map_height);
     
+    //      
+    static std::shared_ptr<NPC> bindNPC(World& world, uint32_t id);
+    
+    //    ,  :   ,   
+    // "<>_NPC_<number>",    createRandomNPC(world, "NPC_<number>")
+    static uint32_t spawnRandomNPC(World& world, uint32_t number, 
+                                   int map_width, int map_height);
+    
     static std::string getRandomType();
 };
 
@@ -0,0 +1,48 @@
+#include "npc_pool.h"
+#include <array>
+
+NPCPool::NPCPool(World& world) : world(world) {
+    //     -     
+    std::array<size_t, NPC_KIND_COUNT> counts{};
+    for (uint32_t id = 0; id < world.size(); ++id) {
+        counts[static_cast<int>(world.kind(id))]++;
+    }
+    bears.reserve(counts[static_cast<int>(NPCKind::Bear)]);
+    werewolves.reserve(counts[static_cast<int>(NPCKind::Werewolf)]);
+    bandits.reserve(counts[static_cast<int>(NPCKind::Bandit)]);
+    
+    for (uint32_t id = 0; id < world.size(); ++id) {
+        switch (world.kind(id)) {
+            case NPCKind::Bear: bears.emplace_back(world, id, &observers); break;
+            case NPCKind::Werewolf: werewolves.emplace_back(world, id, &observers); break;
+            case NPCKind::Bandit: bandits.emplace_back(world, id, &observers); break;
+        }
+    }
+}
+
+std::shared_ptr<NPCPool> NPCPool::create(World& world) {
+    return std::shared_ptr<NPCPool>(new NPCPool(world));
+}
+
+void NPCPool::facades(const std::shared_ptr<NPCPool>& pool, 
+                      std::vector<std::shared_ptr<NPC>>& out) {
+    out.clear();
+    out.reserve(pool->world.size());
+    
+    //       ,    
+    size_t next_bear = 0, next_werewolf = 0, next_bandit = 0;
+    for (uint32_t id = 0; id < pool->world.size(); ++id) {
+        NPC* npc = nullptr;
+        switch (pool->world.kind(id)) {
+            case NPCKind::Bear: npc = &pool->bears[next_bear++]; break;
+            case NPCKind::Werewolf: npc = &pool->werewolves[next_werewolf++]; break;
+            case NPCKind::Bandit: npc = &pool->bandits[next_bandit++]; break;
+        }
+        // :     
+        out.emplace_back(pool, npc);
+    }
+}
+
+void NPCPool::addObserver(const std::shared_ptr<Observer>& observer) {
+    observers.push_back(observer);
+}
\ No newline at end of file
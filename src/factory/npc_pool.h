@@ -0,0 +1,43 @@
+#ifndef NPC_POOL_H
+#define NPC_POOL_H
+
+#include "../npc/bear.h"
+#include "../npc/werewolf.h"
+#include "../npc/bandit.h"
+#include "../observer/observer.h"
+#include "../game/world.h"
+#include <memory>
+#include <vector>
+
+//   NPC      .  
+//   ,    shared_ptr  
+//  -  ,   NPC    
+//   .     
+class NPCPool {
+private:
+    World& world;
+    std::vector<Bear> bears;
+    std::vector<Werewolf> werewolves;
+    std::vector<Bandit> bandits;
+    std::vector<std::shared_ptr<Observer>> observers;
+
+    explicit NPCPool(World& world);
+
+public:
+    NPCPool(const NPCPool&) = delete;
+    NPCPool& operator=(const NPCPool&) = delete;
+
+    //     
+    static std::shared_ptr<NPCPool> create(World& world);
+
+    //  out    ;   
+    static void facades(const std::shared_ptr<NPCPool>& pool, 
+                        std::vector<std::shared_ptr<NPC>>& out);
+
+    //     NPC 
+    void addObserver(const std::shared_ptr<Observer>& observer);
+
+    size_t size() const { return bears.size() + werewolves.size() + bandits.size(); }
+};
+
+#endif
\ No newline at end of file
@@ -1,24 +1,244 @@
 #include "battle_queue.h"
+#include "../utils/trace.h"
 #include <algorithm>
 #include <chrono>
+#include <thread>
 
-void BattleQueue::push(const BattleTask& task) {
-    {
+BattleQueue::PendingPairs::PendingPairs(size_t capacity) {
+    size_t count = 1;
+    while (count * WAYS < capacity * 4) count <<= 1;
+    buckets.reset(new Bucket[count]);
+    bucket_mask = count - 1;
+    clear();
+}
+
+bool BattleQueue::PendingPairs::insert(uint64_t key) {
+    Bucket& bucket = bucketFor(key);
+    for (auto& slot : bucket.slots) {
+        if (slot.load(std::memory_order_relaxed) == key) return false;
+    }
+    for (auto& slot : bucket.slots) {
+        uint64_t expected = 0;
+        if (slot.compare_exchange_strong(expected, key, std::memory_order_relaxed)) {
+            return true;
+        }
+        if (expected == key) return false;
+    }
+    return true;
+}
+
+void BattleQueue::PendingPairs::erase(uint64_t key) {
+    Bucket& bucket = bucketFor(key);
+    for (auto& slot : bucket.slots) {
+        uint64_t expected = key;
+        if (slot.compare_exchange_strong(expected, 0, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void BattleQueue::PendingPairs::clear() {
+    for (size_t i = 0; i <= bucket_mask; ++i) {
+        for (auto& slot : buckets[i].slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+BattleQueue::BattleQueue(Backend backend, size_t capacity, Overflow overflow) 
+    : backend(backend), capacity(std::max<size_t>(1, capacity)), overflow(overflow),
+      pending(this->capacity) {
+    if (backend == Backend::LockFree) {
+        ring = std::make_unique<MPMCRing<BattleTask>>(this->capacity);
+    }
+}
+
+void BattleQueue::onPopped(const BattleTask& task) {
+    pending.erase(PendingPairs::key(task));
+}
+
+bool BattleQueue::reserveRingSlot() {
+    size_t size = ring_size.load(std::memory_order_relaxed);
+    while (size < capacity) {
+        if (ring_size.compare_exchange_weak(size, size + 1, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BattleQueue::ringPush(BattleTask&& task, uint64_t key) {
+    while (!reserveRingSlot()) {
+        if (!running) {
+            pending.erase(key);
+            return false;
+        }
+        
+        if (overflow == Overflow::DropNewest) {
+            pending.erase(key);
+            dropped_overflow.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        if (overflow == Overflow::DropOldest) {
+            //       
+            BattleTask oldest;
+            if (ringTake(oldest)) {
+                dropped_overflow.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        
+        // Block: ,       
+        //  ; stop()      
+        TRACE_SCOPE("push blocked", "queue");
+        wakeConsumer();
+        bool reserved = false;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            blocked.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            space_available.wait(lock, [&]() {
+                reserved = reserveRingSlot();
+                return reserved || !running;
+            });
+            blocked.fetch_sub(1);
+        }
+        if (reserved) break;
+        pending.erase(key);
+        return false;
+    }
+    
+    //   ;      
+    while (!ring->tryPush(task)) {
+        std::this_thread::yield();
+    }
+    wakeConsumer();
+    return true;
+}
+
+bool BattleQueue::ringTake(BattleTask& task) {
+    if (!ring->tryPop(task, [this](const BattleTask& taken) { onPopped(taken); })) {
+        return false;
+    }
+    ring_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void BattleQueue::wakeProducers() {
+    //      ringPush,   wakeConsumer
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (blocked.load(std::memory_order_relaxed) > 0) {
         std::lock_guard<std::mutex> lock(queue_mutex);
-        tasks.push(task);
+        space_available.notify_all();
     }
-    task_available.notify_one();
 }
 
-void BattleQueue::push(BattleTask&& task) {
-    {
+void BattleQueue::wakeConsumer() {
+    //    ringPop:    ,
+    //   ,    
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) > 0) {
         std::lock_guard<std::mutex> lock(queue_mutex);
+        task_available.notify_one();
+    }
+}
+
+bool BattleQueue::ringPop(BattleTask& task, const std::chrono::steady_clock::time_point* deadline) {
+    if (ringTake(task)) {
+        wakeProducers();
+        return true;
+    }
+    
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    waiting.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    
+    bool result = false;
+    while (true) {
+        if (ringTake(task)) {
+            result = true;
+            break;
+        }
+        if (!running) {
+            break;
+        }
+        if (deadline) {
+            if (task_available.wait_until(lock, *deadline) == std::cv_status::timeout) {
+                result = ringTake(task);
+                break;
+            }
+        } else {
+            task_available.wait(lock);
+        }
+    }
+    
+    waiting.fetch_sub(1);
+    lock.unlock();
+    
+    if (result) wakeProducers();
+    return result;
+}
+
+bool BattleQueue::push(const BattleTask& task) {
+    return push(BattleTask(task));
+}
+
+bool BattleQueue::push(BattleTask&& task) {
+    //      -   
+    uint64_t key = PendingPairs::key(task);
+    if (!pending.insert(key)) {
+        dropped_duplicates.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    if (ring) {
+        return ringPush(std::move(task), key);
+    }
+    
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        
+        if (tasks.size() >= capacity) {
+            switch (overflow) {
+                case Overflow::DropNewest:
+                    lock.unlock();
+                    pending.erase(key);
+                    dropped_overflow.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                    
+                case Overflow::DropOldest:
+                    onPopped(tasks.front());
+                    tasks.pop();
+                    dropped_overflow.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                    
+                case Overflow::Block: {
+                    TRACE_SCOPE("push blocked", "queue");
+                    space_available.wait(lock, [this]() {
+                        return tasks.size() < capacity || !running;
+                    });
+                }
+                    if (!running) {
+                        lock.unlock();
+                        pending.erase(key);
+                        return false;
+                    }
+                    break;
+            }
+        }
+        
         tasks.push(std::move(task));
     }
     task_available.notify_one();
+    return true;
 }
 
 bool BattleQueue::pop(BattleTask& task) {
+    if (ring) {
+        return ringPop(task, nullptr);
+    }
+    
     std::unique_lock<std::mutex> lock(queue_mutex);
     
     // ,        
@@ -32,11 +252,19 @@ bool BattleQueue::pop(BattleTask& task) {
     
     task = std::move(tasks.front());
     tasks.pop();
+    onPopped(task);
+    lock.unlock();
     
+    space_available.notify_one();
     return true;
 }
 
 bool BattleQueue::pop(BattleTask& task, std::chrono::milliseconds timeout) {
+    if (ring) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        return ringPop(task, &deadline);
+    }
+    
     std::unique_lock<std::mutex> lock(queue_mutex);
     
     //   
@@ -52,56 +280,105 @@ bool BattleQueue::pop(BattleTask& task, std::chrono::milliseconds timeout) {
     
     task = std::move(tasks.front());
     tasks.pop();
+    onPopped(task);
+    lock.unlock();
     
+    space_available.notify_one();
     return true;
 }
 
+size_t BattleQueue::popBatch(std::vector<BattleTask>& out, size_t max_count) {
+    return popBatchUntil(out, max_count, nullptr);
+}
+
+size_t BattleQueue::popBatch(std::vector<BattleTask>& out, size_t max_count, 
+                             std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return popBatchUntil(out, max_count, &deadline);
+}
+
+size_t BattleQueue::popBatchUntil(std::vector<BattleTask>& out, size_t max_count,
+                                  const std::chrono::steady_clock::time_point* deadline) {
+    out.clear();
+    if (max_count == 0) return 0;
+    
+    if (ring) {
+        //   ,    
+        BattleTask task;
+        if (!ringPop(task, deadline)) {
+            return 0;
+        }
+        out.push_back(task);
+        size_t first = out.size();
+        while (out.size() < max_count && ringTake(task)) {
+            out.push_back(task);
+        }
+        if (out.size() > first) wakeProducers();
+        return out.size();
+    }
+    
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    
+    auto ready = [this]() { return !tasks.empty() || !running; };
+    if (deadline) {
+        if (!task_available.wait_until(lock, *deadline, ready)) {
+            return 0; // 
+        }
+    } else {
+        task_available.wait(lock, ready);
+    }
+    
+    while (!tasks.empty() && out.size() < max_count) {
+        onPopped(tasks.front());
+        out.push_back(std::move(tasks.front()));
+        tasks.pop();
+    }
+    lock.unlock();
+    
+    if (!out.empty()) space_available.notify_all();
+    
+    return out.size();
+}
+
 bool BattleQueue::empty() const {
+    if (ring) {
+        return ring_size.load(std::memory_order_relaxed) == 0;
+    }
+    
     std::lock_guard<std::mutex> lock(queue_mutex);
     return tasks.empty();
 }
 
 size_t BattleQueue::size() const {
+    if (ring) {
+        return ring_size.load(std::memory_order_relaxed);
+    }
+    
     std::lock_guard<std::mutex> lock(queue_mutex);
     return tasks.size();
 }
 
 void BattleQueue::stop() {
     running = false;
+    {
+        //  ,      
+        std::lock_guard<std::mutex> lock(queue_mutex);
+    }
     task_available.notify_all();
+    space_available.notify_all();
 }
 
 void BattleQueue::clear() {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    while (!tasks.empty()) {
-        tasks.pop();
-    }
-}
-
-void BattleQueue::removeDuplicates() {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    
-    //      
-    std::vector<BattleTask> unique_tasks;
-    
-    while (!tasks.empty()) {
-        BattleTask task = std::move(tasks.front());
-        tasks.pop();
-        
-        // ,     
-        auto it = std::find_if(unique_tasks.begin(), unique_tasks.end(),
-            [&task](const BattleTask& t) {
-                return (t.attacker == task.attacker && t.defender == task.defender) ||
-                       (t.attacker == task.defender && t.defender == task.attacker);
-            });
-        
-        if (it == unique_tasks.end()) {
-            unique_tasks.push_back(std::move(task));
+    if (ring) {
+        BattleTask task;
+        while (ringTake(task)) {}
+    } else {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        while (!tasks.empty()) {
+            tasks.pop();
         }
     }
     
-    //      
-    for (auto& task : unique_tasks) {
-        tasks.push(std::move(task));
-    }
+    pending.clear();
+    space_available.notify_all();
 }
\ No newline at end of file
@@ -1,39 +1,143 @@
 #ifndef BATTLE_QUEUE_H
 #define BATTLE_QUEUE_H
 
-#include "../npc/npc.h"
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <memory>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "mpmc_ring.h"
+#include "npc_handle.h"
 
+//    NPC;     
 struct BattleTask {
-    std::shared_ptr<NPC> attacker;
-    std::shared_ptr<NPC> defender;
+    NPCHandle attacker;
+    NPCHandle defender;
     int distance;
+    uint32_t tick;  // ,    
     
     //   
-    BattleTask() : attacker(nullptr), defender(nullptr), distance(0) {}
+    BattleTask() : distance(0), tick(0) {}
     
     //   
-    BattleTask(std::shared_ptr<NPC> a, std::shared_ptr<NPC> d, int dist = 0)
-        : attacker(a), defender(d), distance(dist) {}
+    BattleTask(NPCHandle a, NPCHandle d, int dist = 0, uint32_t t = 0)
+        : attacker(a), defender(d), distance(dist), tick(t) {}
 };
 
 class BattleQueue {
+public:
+    //     
+    enum class Backend {
+        Mutex,      // std::queue  
+        LockFree    //  lock-free  MPMC
+    };
+    
+    //  ,   
+    enum class Overflow {
+        DropOldest, //    
+        DropNewest, //    
+        Block       // ,    
+    };
+    
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    
 private:
+    //  ,    ;     
+    // .       :
+    //      8    ( -), 
+    //   - CAS  . 0 -  :    ,
+    //      
+    class PendingPairs {
+    private:
+        static constexpr size_t WAYS = 8;
+        
+        struct alignas(64) Bucket {
+            std::atomic<uint64_t> slots[WAYS];
+        };
+        
+        std::unique_ptr<Bucket[]> buckets;
+        size_t bucket_mask;
+        
+        Bucket& bucketFor(uint64_t key) {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+            return buckets[key & bucket_mask];
+        }
+        
+    public:
+        //   4      ,  
+        //    
+        explicit PendingPairs(size_t capacity);
+        
+        static uint64_t key(const BattleTask& task) {
+            uint32_t a = task.attacker.raw();
+            uint32_t d = task.defender.raw();
+            uint32_t low = a < d ? a : d;
+            uint32_t high = a < d ? d : a;
+            return (static_cast<uint64_t>(low) << 32) | high;
+        }
+        
+        // false,       .   ,
+        //    :    . 
+        //         - 
+        //    ,     
+        bool insert(uint64_t key);
+        void erase(uint64_t key);
+        void clear();
+    };
+    
+
+    Backend backend;
     std::queue<BattleTask> tasks;
+    std::unique_ptr<MPMCRing<BattleTask>> ring;
     mutable std::mutex queue_mutex;
     std::condition_variable task_available;
     std::atomic<bool> running{true};
     
+    //  ,   task_available (  );
+    //   ,   -  
+    std::atomic<int> waiting{0};
+    
+    size_t capacity;
+    Overflow overflow;
+    std::condition_variable space_available;
+    
+    //      ,     . 
+    //    ,     capacity ,
+    //     ,     
+    std::atomic<size_t> ring_size{0};
+    
+    // ,   space_available (  )
+    std::atomic<int> blocked{0};
+    
+    PendingPairs pending;
+    std::atomic<uint64_t> dropped_duplicates{0};
+    std::atomic<uint64_t> dropped_overflow{0};
+    
 public:
-    BattleQueue() = default;
+    explicit BattleQueue(Backend backend = Backend::Mutex, 
+                         size_t capacity = DEFAULT_CAPACITY,
+                         Overflow overflow = Overflow::Block);
     ~BattleQueue() { stop(); }
     
-    //    
-    void push(const BattleTask& task);
-    void push(BattleTask&& task);
+    Backend getBackend() const { return backend; }
+    Overflow getOverflow() const { return overflow; }
+    size_t getCapacity() const { return capacity; }
+    
+    //   ,    
+    uint64_t getDroppedDuplicates() const { return dropped_duplicates.load(std::memory_order_relaxed); }
+    
+    //  -  (DropOldest  DropNewest)
+    uint64_t getDroppedOverflow() const { return dropped_overflow.load(std::memory_order_relaxed); }
+    
+    //    ;    ,
+    // false -     
+    bool push(const BattleTask& task);
+    bool push(BattleTask&& task);
     
     //   ( )
     bool pop(BattleTask& task);
@@ -41,10 +145,18 @@ public:
     //    
     bool pop(BattleTask& task, std::chrono::milliseconds timeout);
     
+    //   max_count     ;  
+    // , 0 -    
+    size_t popBatch(std::vector<BattleTask>& out, size_t max_count);
+    
+    //  ,     timeout
+    size_t popBatch(std::vector<BattleTask>& out, size_t max_count, 
+                    std::chrono::milliseconds timeout);
+    
     // ,   
     bool empty() const;
     
-    //   
+    //    ( )
     size_t size() const;
     
     //  
@@ -54,8 +166,19 @@ public:
     void clear();
     
 private:
-    //   
-    void removeDuplicates();
+    //  
+    bool ringPush(BattleTask&& task, uint64_t key);
+    bool ringTake(BattleTask& task);
+    bool reserveRingSlot();
+    void wakeProducers();
+    bool ringPop(BattleTask& task, const std::chrono::steady_clock::time_point* deadline);
+    void wakeConsumer();
+    size_t popBatchUntil(std::vector<BattleTask>& out, size_t max_count,
+                         const std::chrono::steady_clock::time_point* deadline);
+    
+    //    ;   ,    
+    //   ,      
+    void onPopped(const BattleTask& task);
 };
 
 #endif
\ No newline at end of file
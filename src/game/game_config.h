@@ -0,0 +1,59 @@
+#ifndef GAME_CONFIG_H
+#define GAME_CONFIG_H
+
+#include "battle_queue.h"
+#include "../shard/transport.h"
+#include <string>
+
+//  ,    
+struct GameConfig {
+    //   :   ,   ,
+    //          -
+    //  
+    enum class Scheduler {
+        Threads,
+        Jobs,
+        Regions
+    };
+    
+    int map_width = 100;
+    int map_height = 100;
+    int total_npcs = 50;
+    int game_duration = 30;     //     
+    int display_width = 40;     //     
+    int display_height = 10;
+    
+    //  :   ,    
+    bool headless = false;
+    int ticks = 1000;
+    
+    int movement_threads = 0;   // 0 -   
+    int battle_threads = 0;     // 0 -   
+    Scheduler scheduler = Scheduler::Threads;
+    int job_workers = 0;        // 0 -   
+    int regions = 0;            //     Regions, 0 -   
+    
+    // -  (1 -    )    
+    int shards = 1;
+    Transport::Kind shard_transport = Transport::Kind::SharedMemory;
+    BattleQueue::Backend queue_backend = BattleQueue::Backend::LockFree;
+    size_t queue_capacity = BattleQueue::DEFAULT_CAPACITY;
+    //    ,   
+    BattleQueue::Overflow queue_overflow = BattleQueue::Overflow::DropOldest;
+    
+    std::string log_path = "log.txt";   //  
+    int log_flush_ms = 50;      //    
+    size_t log_capacity = 1 << 16;  //    ,  
+    
+    //     Prometheus ( -  )   
+    std::string metrics_path;
+    int metrics_interval_ms = 1000;
+    
+    //  NPC      make_shared  
+    bool pooled_npcs = true;
+    
+    std::string load_path;      //    
+    std::string save_path;      //    
+};
+
+#endif
\ No newline at end of file
@@ -1,44 +1,91 @@
 #include "game_manager.h"
 #include "../factory/npc_factory.h"
+#include "../factory/npc_pool.h"
 #include "../observer/console_observer.h"
 #include "../observer/file_observer.h"
+#include "world_file.h"
+#include "terminal_renderer.h"
+#include <fstream>
+#include <cstdio>
 #include "../utils/dice.h"
+#include "../utils/random.h"
+#include "../utils/trace.h"
+#include "../utils/proximity_kernel.h"
+#include "../utils/job_system.h"
+#include "../utils/barrier.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
+#include <cmath>
+#include <unistd.h>
 
 //   
 std::mutex GameManager::cout_mutex;
 
-GameManager::GameManager() {
-    //  
-    observers.push_back(std::make_shared<ConsoleObserver>());
-    observers.push_back(std::make_shared<FileObserver>());
+GameManager::GameManager(const GameConfig& config)
+    : battle_queue(config.queue_backend, config.queue_capacity, config.queue_overflow), 
+      config(config) {
+    setMovementThreads(config.movement_threads);
+    setBattleThreads(config.battle_threads);
+    
+    //  ;      
+    if (!config.headless) {
+        observers.push_back(std::make_shared<ConsoleObserver>());
+    }
+    kill_log = std::make_shared<FileObserver>(
+        config.log_path, std::chrono::milliseconds(config.log_flush_ms), config.log_capacity);
+    observers.push_back(kill_log);
 }
 
 GameManager::~GameManager() {
     stop();
 }
 
+void GameManager::setMovementThreads(int count) {
+    if (count <= 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    movement_threads = std::max(1, count);
+}
+
+void GameManager::setBattleThreads(int count) {
+    if (count <= 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    battle_worker_count = std::max(1, count);
+}
+
 void GameManager::initialize() {
     safePrint("=== Balagur Fate 3 - Multi-threaded Simulation ===");
     safePrint("Variant 5: Bear, Werewolf, Bandit");
     safePrint("==================================================");
     safePrint("Initializing game...");
-    safePrint("Map size: " + std::to_string(MAP_WIDTH) + "x" + std::to_string(MAP_HEIGHT));
-    safePrint("Creating " + std::to_string(TOTAL_NPCS) + " NPCs...");
     
-    addRandomNPCs(TOTAL_NPCS);
+    //      ,   NPC
+    if (!config.load_path.empty()) {
+        safePrint("Loading world from '" + config.load_path + "'...");
+        loadWorld(config.load_path);
+    }
     
-    //     NPC
-    for (auto& npc : npcs) {
-        for (auto& observer : observers) {
-            npc->addObserver(observer);
-        }
+    safePrint("Map size: " + std::to_string(config.map_width) + "x" + std::to_string(config.map_height));
+    safePrint("Seed: " + std::to_string(Random::getSeed()));
+    
+    if (config.load_path.empty()) {
+        safePrint("Creating " + std::to_string(config.total_npcs) + " NPCs...");
+        addRandomNPCs(config.total_npcs);
+    } else {
+        safePrint("Loaded " + std::to_string(world.size()) + " NPCs, " +
+                  std::to_string(countAliveNPCs()) + " alive");
     }
     
+    //       
+    grid.configure(config.map_width, config.map_height, MAX_KILL_DISTANCE);
+    
+    //  ,      
+    snapshots.publish(world, 0);
+    
     safePrint("Game initialized successfully!");
     safePrint("Rules:");
     safePrint("  - Werewolf kills Bandit");
@@ -50,318 +97,1011 @@ void GameManager::initialize() {
 }
 
 void GameManager::start() {
+    stop_signal.reset();
     game_running = true;
     game_time = 0;
+    tick = 0;
     total_battles = 0;
     total_kills = 0;
     
-    //    -
-    movement_thread = std::thread([this]() { movementWorker(); });
-    battle_thread = std::thread([this]() { battleWorker(); });
-    display_thread = std::thread([this]() { displayWorker(); });
+    started_at = std::chrono::steady_clock::now();
+    stopped_at = started_at;
+    
+    if (config.scheduler == GameConfig::Scheduler::Jobs) {
+        //       ,    
+        startJobs();
+        scheduler_thread = std::thread([this]() { schedulerWorker(); });
+    } else if (config.scheduler == GameConfig::Scheduler::Regions) {
+        //    ,    
+        startRegions();
+        display_thread = std::thread([this]() { displayWorker(); });
+    } else {
+        //    -
+        movement_thread = std::thread([this]() { movementWorker(); });
+        for (int i = 0; i < battle_worker_count; ++i) {
+            battle_threads.emplace_back([this]() { battleWorker(); });
+        }
+        display_thread = std::thread([this]() { displayWorker(); });
+    }
     
-    safePrint("Game started! Duration: " + std::to_string(GAME_DURATION) + " seconds");
+    safePrint("Game started! Duration: " + std::to_string(config.game_duration) + " seconds");
 }
 
 void GameManager::stop() {
-    game_running = false;
+    bool was_running = game_running.exchange(false);
+    stop_signal.raise();
     battle_queue.stop();
     
     if (movement_thread.joinable()) movement_thread.join();
-    if (battle_thread.joinable()) battle_thread.join();
+    stopMoveWorkers();
+    for (auto& thread : battle_threads) {
+        if (thread.joinable()) thread.join();
+    }
+    battle_threads.clear();
     if (display_thread.joinable()) display_thread.join();
+    if (scheduler_thread.joinable()) scheduler_thread.join();
+    stopJobs();
+    joinRegions();
+    
+    if (was_running) {
+        stopped_at = std::chrono::steady_clock::now();
+        
+        //  ,     
+        snapshots.publish(world, tick.load());
+    }
     
     battle_queue.clear();
+    
+    //  ,     
+    deliverKills();
+    
+    if (was_running) writeMetrics();
+    
+    //    ,    
+    for (auto& observer : observers) {
+        observer->flush();
+    }
+}
+
+void GameManager::requestStop() {
+    //  :     ,   run()
+    stop_signal.raise();
 }
 
 void GameManager::run() {
+    if (config.headless) {
+        runHeadless();
+        return;
+    }
+    
     initialize();
     start();
     
-    //   
-    for (int i = 0; i < GAME_DURATION && game_running; ++i) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+    //   ;    
+    auto second_ends = std::chrono::steady_clock::now();
+    for (int i = 0; i < config.game_duration && game_running; ++i) {
+        second_ends += std::chrono::seconds(1);
+        if (stop_signal.waitUntil(second_ends)) break;
         game_time++;
     }
     
+    if (stop_signal.isRaised()) {
+        safePrint("\n\nReceived interrupt signal. Stopping game...");
+    }
     stop();
     printFinalReport();
+    
+    if (!config.save_path.empty()) saveWorld(config.save_path);
+}
+
+void GameManager::runHeadless() {
+    initialize();
+    
+    stop_signal.reset();
+    game_running = true;
+    game_time = 0;
+    tick = 0;
+    total_battles = 0;
+    total_kills = 0;
+    
+    safePrint("Headless run: " + std::to_string(config.ticks) + " ticks");
+    if (config.scheduler == GameConfig::Scheduler::Jobs) {
+        startJobs();
+    }
+    
+    started_at = std::chrono::steady_clock::now();
+    
+    if (config.scheduler == GameConfig::Scheduler::Regions) {
+        //    config.ticks   
+        startRegions();
+        joinRegions();
+    } else {
+        std::vector<BattleTask> tick_battles;
+        for (int i = 0; i < config.ticks && game_running && !stop_signal.isRaised(); ++i) {
+            stepTick(tick_battles);
+            maybeWriteMetrics();
+        }
+    }
+    
+    if (stop_signal.isRaised()) {
+        safePrint("\n\nReceived interrupt signal. Stopping game...");
+    }
+    stopped_at = std::chrono::steady_clock::now();
+    game_running = false;
+    stopMoveWorkers();
+    stopJobs();
+    
+    //       ,  
+    snapshots.publish(world, tick.load());
+    writeMetrics();
+    
+    printFinalReport();
+    
+    if (!config.save_path.empty()) saveWorld(config.save_path);
 }
 
 void GameManager::movementWorker() {
+    Trace::setThreadName("movement");
     safePrint("Movement thread started");
     
+    std::vector<BattleTask> tick_battles;
+    
     while (game_running) {
         auto start_time = std::chrono::steady_clock::now();
         
         //    ()
-        std::unique_lock<std::shared_mutex> lock(npcs_mutex);
-        
-        //    NPC
-        int moved_count = 0;
-        for (auto& npc : npcs) {
-            if (npc->isAlive()) {
-                npc->moveRandomly(MAP_WIDTH, MAP_HEIGHT);
-                moved_count++;
-            }
+        //    ,     
+        std::unique_lock<std::shared_mutex> lock(npcs_mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            TRACE_SCOPE("wait npcs_mutex", "lock");
+            lock.lock();
         }
         
-        //  
-        int collision_count = 0;
-        std::set<std::pair<std::shared_ptr<NPC>, std::shared_ptr<NPC>>> checked_pairs;
+        //    NPC    
+        tick++;
+        {
+            PhaseTimer timer(metrics, TickPhase::Move);
+            moveAll();
+        }
         
-        for (size_t i = 0; i < npcs.size(); ++i) {
-            if (!npcs[i]->isAlive()) continue;
-            
-            for (size_t j = i + 1; j < npcs.size(); ++j) {
-                if (!npcs[j]->isAlive()) continue;
-                
-                // ,       
-                auto pair = std::make_pair(npcs[i], npcs[j]);
-                if (checked_pairs.count(pair)) continue;
-                checked_pairs.insert(pair);
-                
-                double distance = npcs[i]->calculateDistance(npcs[j]);
-                int kill_distance_i = npcs[i]->getKillDistance();
-                int kill_distance_j = npcs[j]->getKillDistance();
-                
-                // NPC    ,      kill_distance
-                if (distance <= kill_distance_i || distance <= kill_distance_j) {
-                    // ,   (,    )
-                    if (npcs[i]->canKill(npcs[j])) {
-                        battle_queue.push({npcs[i], npcs[j], static_cast<int>(distance)});
-                    } else if (npcs[j]->canKill(npcs[i])) {
-                        battle_queue.push({npcs[j], npcs[i], static_cast<int>(distance)});
-                    }
-                    collision_count++;
-                }
-            }
+        //      
+        {
+            PhaseTimer timer(metrics, TickPhase::Collision);
+            rebuildGrid();
+            detectCollisions(tick.load(), tick_battles);
         }
         
         lock.unlock();
-
         
-        auto end_time = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        //     ,   
+        //   ;    
+        {
+            TRACE_SCOPE("publish snapshot", "tick");
+            snapshots.publish(world, tick.load());
+        }
         
-        //   ( 10   )
-        if (elapsed < std::chrono::milliseconds(100)) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100) - elapsed);
+        //        
+        {
+            PhaseTimer timer(metrics, TickPhase::Enqueue);
+            for (const auto& task : tick_battles) {
+                battle_queue.push(task);
+            }
         }
+        
+        // ,        
+        deliverKills();
+        
+        maybeWriteMetrics();
+        
+        //   ( 10   );
+        //    
+        stop_signal.waitUntil(start_time + std::chrono::milliseconds(100));
     }
     
     safePrint("Movement thread stopped");
 }
 
-void GameManager::battleWorker() {
-    safePrint("Battle thread started");
+void GameManager::rebuildGrid() {
+    const int* xs = world.xData();
+    const int* ys = world.yData();
     
-    while (game_running) {
-        BattleTask task;
+    grid.clear();
+    for (uint32_t id = 0; id < world.size(); ++id) {
+        if (world.isAlive(id)) {
+            int reach = kindKillDistance(world.kind(id));
+            grid.insert(id, xs[id], ys[id], reach * reach);
+        }
+    }
+    grid.build();
+}
+
+int GameManager::detectCollisions(uint32_t collision_tick, std::vector<BattleTask>& out) {
+    out.clear();
+    return detectCollisionRows(0, grid.getRows(), collision_tick, out, collision_scratch);
+}
+
+template <typename Fn>
+int GameManager::forEachKillPair(const SpatialGrid& pairs_grid, int row_begin, int row_end,
+                                 CollisionBand& scratch, Fn&& fn) const {
+    const uint32_t* ids = pairs_grid.ids();
+    const int* xs = pairs_grid.xs();
+    const int* ys = pairs_grid.ys();
+    const int* reach_sq = pairs_grid.reachSq();
+    
+    //      , 
+    //  NPC      :
+    // NPC   ,       kill_distance
+    int collision_count = 0;
+    pairs_grid.forEachCandidateRun(row_begin, row_end, [&](uint32_t a, uint32_t begin, uint32_t end) {
+        size_t count = end - begin;
+        if (scratch.hits.size() < count) {
+            scratch.hits.resize(count);
+            scratch.dist_sq.resize(count);
+        }
+        size_t hit_count = ProximityKernel::collectInReach(
+            xs[a], ys[a], reach_sq[a], xs + begin, ys + begin, reach_sq + begin,
+            count, scratch.hits.data(), scratch.dist_sq.data());
         
-        //       
-        if (battle_queue.pop(task, std::chrono::milliseconds(50))) {
-            total_battles++;
+        for (size_t i = 0; i < hit_count; ++i) {
+            int distance = static_cast<int>(std::sqrt(static_cast<double>(scratch.dist_sq[i])));
+            fn(ids[a], ids[begin + scratch.hits[i]], distance);
+            collision_count++;
+        }
+    });
+    
+    return collision_count;
+}
+
+void GameManager::appendBattle(uint32_t a, uint32_t b, int distance, uint32_t battle_tick,
+                               std::vector<BattleTask>& out) const {
+    NPCKind kind_a = world.kind(a);
+    NPCKind kind_b = world.kind(b);
+    
+    // ,   (,    )
+    if (kindCanKill(kind_a, kind_b)) {
+        out.push_back({world.handle(a), world.handle(b), distance, battle_tick});
+    } else if (kindCanKill(kind_b, kind_a)) {
+        out.push_back({world.handle(b), world.handle(a), distance, battle_tick});
+    }
+}
+
+int GameManager::detectCollisionRows(int row_begin, int row_end, uint32_t collision_tick,
+                                     std::vector<BattleTask>& out, CollisionBand& scratch) {
+    return forEachKillPair(grid, row_begin, row_end, scratch, [&](uint32_t a, uint32_t b, int distance) {
+        appendBattle(a, b, distance, collision_tick, out);
+    });
+}
+
+void GameManager::stepTick(std::vector<BattleTask>& tick_battles) {
+    if (tick_graph) {
+        runTickGraph();
+        return;
+    }
+    
+    tick++;
+    {
+        PhaseTimer timer(metrics, TickPhase::Move);
+        moveAll();
+    }
+    {
+        PhaseTimer timer(metrics, TickPhase::Collision);
+        rebuildGrid();
+        detectCollisions(tick.load(), tick_battles);
+    }
+    
+    //       ,  
+    {
+        PhaseTimer timer(metrics, TickPhase::BattleResolve);
+        for (const auto& task : tick_battles) {
             processBattle(task);
         }
-        
-        //  ,    CPU
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
+    total_battles += static_cast<int>(tick_battles.size());
+    deliverKills();
+}
+
+void GameManager::startJobs() {
+    job_system = std::make_unique<JobSystem>(config.job_workers);
+    buildTickGraph();
+    if (!config.headless) {
+        job_renderer = std::make_unique<TerminalRenderer>(STDOUT_FILENO);
+    }
+    safePrint("Job scheduler: " + std::to_string(job_system->workerCount()) + " workers");
+}
+
+void GameManager::stopJobs() {
+    if (!job_system) return;
     
-    safePrint("Battle thread stopped");
+    job_worker_count = job_system->workerCount();
+    jobs_stolen = job_system->getStolen();
+    
+    //     ( )  
+    job_system.reset();
+    tick_graph.reset();
+    
+    if (job_renderer) {
+        std::lock_guard<std::mutex> cout_lock(cout_mutex);
+        std::cout.flush();
+        job_renderer->finish();
+        job_renderer.reset();
+    }
 }
 
-void GameManager::displayWorker() {
-    safePrint("Display thread started");
+void GameManager::buildTickGraph() {
+    tick_graph = std::make_unique<JobGraph>();
+    JobGraph& graph = *tick_graph;
     
-    const int BAR_WIDTH = 40;
+    // :     ,
+    //       
+    move_node = graph.addParallel("move",
+        [this]() { return std::max<size_t>(1, (world.size() + MIN_MOVE_CHUNK - 1) / MIN_MOVE_CHUNK); },
+        [this](size_t part) {
+            uint32_t total = static_cast<uint32_t>(world.size());
+            uint32_t begin = std::min<uint32_t>(total, static_cast<uint32_t>(part) * MIN_MOVE_CHUNK);
+            moveRange(begin, std::min(total, begin + MIN_MOVE_CHUNK), tick.load());
+        });
+    
+    //     
+    grid_node = graph.add("rebuild grid", [this]() { rebuildGrid(); });
+    
+    //     ,     ,
+    //      
+    collide_node = graph.addParallel("collide",
+        [this]() {
+            size_t bands = std::min<size_t>(grid.getRows(), job_system->workerCount() * 4);
+            collision_bands.resize(std::max<size_t>(1, bands));
+            return collision_bands.size();
+        },
+        [this](size_t part) {
+            size_t rows = grid.getRows();
+            size_t bands = collision_bands.size();
+            CollisionBand& band = collision_bands[part];
+            band.battles.clear();
+            detectCollisionRows(static_cast<int>(rows * part / bands), 
+                                static_cast<int>(rows * (part + 1) / bands),
+                                tick.load(), band.battles, band);
+        });
+    
+    //     ,   
+    //     
+    size_t merge_node = graph.add("merge battles", [this]() {
+        job_battles.clear();
+        for (const auto& band : collision_bands) {
+            job_battles.insert(job_battles.end(), band.battles.begin(), band.battles.end());
+        }
+    });
+    
+    //          ,  
+    //        ;  -    
+    bool ordered = config.headless;
+    size_t battle_node = graph.addParallel("battles",
+        [this, ordered]() -> size_t {
+            if (job_battles.empty()) return 0;
+            return ordered ? 1 : (job_battles.size() + BATTLE_BATCH_SIZE - 1) / BATTLE_BATCH_SIZE;
+        },
+        [this, ordered](size_t part) {
+            size_t begin = ordered ? 0 : part * BATTLE_BATCH_SIZE;
+            size_t end = ordered ? job_battles.size() : std::min(job_battles.size(), begin + BATTLE_BATCH_SIZE);
+            
+            PhaseTimer timer(metrics, TickPhase::BattleResolve);
+            for (size_t i = begin; i < end; ++i) {
+                processBattle(job_battles[i]);
+            }
+        });
+    
+    graph.precede(move_node, grid_node);
+    graph.precede(grid_node, collide_node);
+    graph.precede(collide_node, merge_node);
+    graph.precede(merge_node, battle_node);
+    
+    //    ,   
+    size_t deliver_node = graph.add("deliver kills", [this]() { deliverKills(); });
+    graph.precede(battle_node, deliver_node);
+    
+    //     ;       
+    if (!config.headless) {
+        size_t publish_node = graph.add("publish snapshot", [this]() {
+            snapshots.publish(world, tick.load());
+        });
+        graph.precede(battle_node, publish_node);
+    }
+}
+
+void GameManager::runTickGraph() {
+    std::unique_lock<std::shared_mutex> lock(npcs_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        TRACE_SCOPE("wait npcs_mutex", "lock");
+        lock.lock();
+    }
+    
+    tick++;
+    tick_graph->run(*job_system);
+    
+    metrics.record(TickPhase::Move, tick_graph->duration(move_node));
+    metrics.record(TickPhase::Collision, 
+                   tick_graph->duration(grid_node) + tick_graph->duration(collide_node));
+    total_battles += static_cast<int>(job_battles.size());
+}
+
+void GameManager::schedulerWorker() {
+    Trace::setThreadName("scheduler");
+    safePrint("Scheduler thread started");
+    
+    auto rendered_at = std::chrono::steady_clock::now() - std::chrono::seconds(1);
     
     while (game_running) {
         auto start_time = std::chrono::steady_clock::now();
         
-        std::shared_lock<std::shared_mutex> lock(npcs_mutex);
+        //    ;   ,  
+        runTickGraph();
+        maybeWriteMetrics();
         
-        //  
-        int progress = 0;
-        if (GAME_DURATION > 0) {
-            progress = (game_time * BAR_WIDTH) / GAME_DURATION;
+        //      ,     
+        if (start_time - rendered_at >= std::chrono::seconds(1) && !render_pending.exchange(true)) {
+            rendered_at = start_time;
+            job_system->submit([this]() {
+                renderFrame(*job_renderer);
+                render_pending = false;
+            });
         }
-        if (progress > BAR_WIDTH) progress = BAR_WIDTH;
         
-        //  
-        int alive_count = countAliveNPCs();
-        auto type_counts = countNPCsByType();
+        //   ,     ( 10   )
+        stop_signal.waitUntil(start_time + std::chrono::milliseconds(100));
+    }
+    
+    safePrint("Scheduler thread stopped");
+}
+
+void GameManager::startRegions() {
+    //     :    
+    //           
+    int count = config.regions > 0 ? config.regions 
+                                   : static_cast<int>(std::thread::hardware_concurrency());
+    count = std::max(1, std::min(count, config.map_width / MAX_KILL_DISTANCE));
+    region_width = (config.map_width + count - 1) / count;
+    count = (config.map_width + region_width - 1) / region_width;
+    
+    regions.clear();
+    for (int i = 0; i < count; ++i) {
+        auto region = std::make_unique<Region>();
+        region->left = i * region_width;
+        region->right = std::min(config.map_width, region->left + region_width);
+        region->migrants.resize(count);
+        region->ghosts.resize(count);
+        //         
+        region->grid.configure(region->right - region->left + 2 * MAX_KILL_DISTANCE, 
+                               config.map_height, MAX_KILL_DISTANCE);
+        regions.push_back(std::move(region));
+    }
+    
+    for (uint32_t id = 0; id < world.size(); ++id) {
+        if (world.isAlive(id)) {
+            regions[regionOf(world.x(id))]->owned.push_back(id);
+        }
+    }
+    
+    region_barrier = std::make_unique<Barrier>(regions.size());
+    regions_stopping = false;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        region_threads.emplace_back([this, i]() { regionWorker(i); });
+    }
+    
+    safePrint("Regions: " + std::to_string(count) + " strips of " + 
+              std::to_string(region_width) + " columns");
+}
+
+void GameManager::joinRegions() {
+    for (auto& thread : region_threads) {
+        if (thread.joinable()) thread.join();
+    }
+    region_threads.clear();
+}
+
+size_t GameManager::regionOf(int x) const {
+    return std::min(regions.size() - 1, static_cast<size_t>(x / region_width));
+}
+
+void GameManager::regionWorker(size_t index) {
+    Trace::setThreadName("region " + std::to_string(index));
+    Region& region = *regions[index];
+    const bool leader = index == 0;
+    
+    for (;;) {
+        //   ,    
+        auto tick_started = std::chrono::steady_clock::now();
+        if (leader) {
+            bool finished = !game_running || stop_signal.isRaised() ||
+                            (config.headless && tick.load() >= static_cast<uint32_t>(config.ticks));
+            regions_stopping = finished;
+            if (!finished) tick++;
+        }
+        region_barrier->wait();
+        if (regions_stopping) break;
         
-        //  
-        std::lock_guard<std::mutex> cout_lock(cout_mutex);
+        uint32_t current_tick = tick.load();
         
-        //      (Linux/Mac)
-        std::cout << "\033[2J\033[1;1H";
-        //   Windows:
-        // system("cls");
+        //       NPC
+        {
+            PhaseTimer timer(metrics, TickPhase::Move);
+            moveRegion(index, current_tick);
+        }
+        region_barrier->wait();
         
-        // 
-        std::cout << "=== Balagur Fate 3 - Real-time Simulation ===" << std::endl;
-        std::cout << "Time: " << game_time << "s / " << GAME_DURATION << "s" << std::endl;
-        std::cout << std::string(50, '=') << std::endl;
+        //       NPC
+        {
+            PhaseTimer timer(metrics, TickPhase::Collision);
+            collideRegion(index, current_tick);
+        }
+        {
+            PhaseTimer timer(metrics, TickPhase::BattleResolve);
+            resolveRegionBattles(region.local_battles);
+        }
+        region_barrier->wait();
         
-        // -
-        std::cout << "[";
-        for (int i = 0; i < BAR_WIDTH; i++) {
-            if (i < progress) std::cout << "=";
-            else std::cout << ".";
+        //   :  i     i+1, 
+        //    ,  ,     
+        for (size_t parity = 0; parity < 2; ++parity) {
+            if (index % 2 == parity && !region.cross_battles.empty()) {
+                PhaseTimer timer(metrics, TickPhase::BattleResolve);
+                resolveRegionBattles(region.cross_battles);
+            }
+            region_barrier->wait();
         }
-        std::cout << "]" << std::endl;
+        total_battles += static_cast<int>(region.local_battles.size() + region.cross_battles.size());
         
-        // 
-        std::cout << "\nStatistics:" << std::endl;
-        std::cout << "  Alive: " << alive_count << "/" << npcs.size() 
-                  << "  Battles: " << total_battles.load()
-                  << "  Kills: " << total_kills.load() 
-                  << "  Queue: " << battle_queue.size() << std::endl;
-        std::cout << "  Bears: " << type_counts["Bear"] 
-                  << "  Werewolves: " << type_counts["Werewolf"]
-                  << "  Bandits: " << type_counts["Bandit"] << std::endl;
+        //       ,
+        //       
+        if (leader) {
+            deliverKills();
+            if (!config.headless) {
+                TRACE_SCOPE("publish snapshot", "tick");
+                snapshots.publish(world, current_tick);
+            }
+            maybeWriteMetrics();
+            
+            //   ,     ( 10   )
+            if (!config.headless) {
+                stop_signal.waitUntil(tick_started + std::chrono::milliseconds(100));
+            }
+        }
+    }
+}
+
+void GameManager::moveRegion(size_t index, uint32_t move_tick) {
+    Region& region = *regions[index];
+    for (auto& list : region.migrants) list.clear();
+    for (auto& list : region.ghosts) list.clear();
+    
+    size_t kept = 0;
+    for (uint32_t id : region.owned) {
+        if (!world.isAlive(id)) continue; //    
         
-        std::cout << std::string(50, '-') << std::endl;
+        moveOne(id, move_tick);
+        int x = world.x(id);
+        size_t owner = regionOf(x);
+        if (owner == index) {
+            region.owned[kept++] = id;
+        } else {
+            region.migrants[owner].push_back(id);
+        }
         
-        //     -  !
-        std::cout << "Real-time Map (only alive NPCs):" << std::endl;
-        printMap();  //   
+        //  NPC       
+        const Region& home = *regions[owner];
+        if (owner > 0 && x < home.left + MAX_KILL_DISTANCE) {
+            region.ghosts[owner - 1].push_back(id);
+        }
+        if (owner + 1 < regions.size() && x >= home.right - MAX_KILL_DISTANCE) {
+            region.ghosts[owner + 1].push_back(id);
+        }
+    }
+    region.owned.resize(kept);
+}
+
+void GameManager::collideRegion(size_t index, uint32_t collision_tick) {
+    Region& region = *regions[index];
+    
+    //     
+    for (const auto& other : regions) {
+        const auto& incoming = other->migrants[index];
+        region.owned.insert(region.owned.end(), incoming.begin(), incoming.end());
+    }
+    
+    //     :      
+    const int origin = region.left - MAX_KILL_DISTANCE;
+    auto insert = [&](uint32_t id) {
+        int reach = kindKillDistance(world.kind(id));
+        region.grid.insert(id, world.x(id) - origin, world.y(id), reach * reach);
+    };
+    region.grid.clear();
+    for (uint32_t id : region.owned) insert(id);
+    for (const auto& other : regions) {
+        for (uint32_t id : other->ghosts[index]) insert(id);
+    }
+    region.grid.build();
+    
+    collideStrip(region.grid, region.scratch, index, region_width, regions.size(), 
+                 collision_tick, region.local_battles, region.cross_battles);
+}
+
+void GameManager::collideStrip(const SpatialGrid& strip_grid, CollisionBand& scratch, size_t index,
+                               int strip_width, size_t strip_count, uint32_t collision_tick,
+                               std::vector<BattleTask>& local, std::vector<BattleTask>& cross) const {
+    auto ownerOf = [&](int x) {
+        return std::min(strip_count - 1, static_cast<size_t>(x / strip_width));
+    };
+    
+    //        ,   -  
+    local.clear();
+    cross.clear();
+    forEachKillPair(strip_grid, 0, strip_grid.getRows(), scratch, 
+                    [&](uint32_t a, uint32_t b, int distance) {
+        size_t owner_a = ownerOf(world.x(a));
+        size_t owner_b = ownerOf(world.x(b));
+        if (owner_a == index && owner_b == index) {
+            appendBattle(a, b, distance, collision_tick, local);
+        } else if ((owner_a == index && owner_b == index + 1) || 
+                   (owner_b == index && owner_a == index + 1)) {
+            appendBattle(a, b, distance, collision_tick, cross);
+        }
+    });
+}
+
+void GameManager::resolveRegionBattles(const std::vector<BattleTask>& tasks) {
+    //    ,     
+    for (const auto& task : tasks) {
+        uint32_t attacker, defender;
+        if (!world.resolve(task.attacker, attacker) || !world.resolve(task.defender, defender)) {
+            continue;
+        }
+        if (!world.isAlive(attacker) || !world.isAlive(defender)) {
+            continue;
+        }
+        resolveBattle(attacker, defender, task.tick);
+    }
+}
+
+void GameManager::moveOne(uint32_t id, uint32_t move_tick) {
+    int move_distance = kindMoveDistance(world.kind(id));
+    auto words = Random::block(move_tick, id, RandomPurpose::Move);
+    int dx = Random::toRange(words[0], -move_distance, move_distance);
+    int dy = Random::toRange(words[1], -move_distance, move_distance);
+    int* xs = world.xData();
+    int* ys = world.yData();
+    xs[id] = std::max(0, std::min(config.map_width - 1, xs[id] + dx));
+    ys[id] = std::max(0, std::min(config.map_height - 1, ys[id] + dy));
+}
+
+int GameManager::moveRange(uint32_t begin, uint32_t end, uint32_t move_tick) {
+    int moved_count = 0;
+    for (uint32_t id = begin; id < end; ++id) {
+        if (!world.isAlive(id)) continue;
+        moveOne(id, move_tick);
+        moved_count++;
+    }
+    
+    return moved_count;
+}
+
+int GameManager::moveAll() {
+    uint32_t total = static_cast<uint32_t>(world.size());
+    uint32_t move_tick = tick.load();
+    
+    //      
+    uint32_t workers = std::min<uint32_t>(movement_threads, 
+                                          std::max<uint32_t>(1, total / MIN_MOVE_CHUNK));
+    if (workers <= 1) {
+        return moveRange(0, total, move_tick);
+    }
+    
+    //    ,     
+    if (move_workers.size() + 1 != workers) {
+        stopMoveWorkers();
+        startMoveWorkers(workers);
+    }
+    
+    //       ,
+    //       
+    move_total = total;
+    move_chunk = (total + workers - 1) / workers;
+    move_pass_tick = move_tick;
+    
+    move_barrier->wait();   //  
+    move_counts[0] = moveRange(0, std::min(total, move_chunk), move_tick);
+    move_barrier->wait();   //   
+    
+    int moved_count = 0;
+    for (int count : move_counts) moved_count += count;
+    return moved_count;
+}
+
+void GameManager::startMoveWorkers(uint32_t workers) {
+    move_barrier = std::make_unique<Barrier>(workers);
+    move_stopping = false;
+    move_counts.assign(workers, 0);
+    for (uint32_t w = 1; w < workers; ++w) {
+        move_workers.emplace_back([this, w]() { moveWorker(w); });
+    }
+}
+
+void GameManager::stopMoveWorkers() {
+    if (move_workers.empty()) return;
+    
+    //    ;     
+    move_stopping = true;
+    move_barrier->wait();
+    for (auto& thread : move_workers) {
+        thread.join();
+    }
+    move_workers.clear();
+    move_barrier.reset();
+}
+
+void GameManager::moveWorker(uint32_t index) {
+    Trace::setThreadName("move worker " + std::to_string(index));
+    
+    for (;;) {
+        //         
+        move_barrier->wait();
+        if (move_stopping) break;
         
-        // 
-        std::cout << "Legend: B=Bear  W=Werewolf  R=Bandit" << std::endl;
-        std::cout << std::string(50, '=') << std::endl;
+        uint32_t begin = std::min(move_total, index * move_chunk);
+        uint32_t end = std::min(move_total, begin + move_chunk);
+        move_counts[index] = moveRange(begin, end, move_pass_tick);
+        move_barrier->wait();
+    }
+}
+
+void GameManager::battleWorker() {
+    Trace::setThreadName("battle");
+    safePrint("Battle thread started");
+    
+    std::vector<BattleTask> batch;
+    batch.reserve(BATTLE_BATCH_SIZE);
+    
+    while (game_running) {
+        //          ;
+        // stop()  ,   
+        size_t popped;
+        {
+            TRACE_SCOPE("pop batch", "queue");
+            popped = battle_queue.popBatch(batch, BATTLE_BATCH_SIZE);
+        }
+        if (popped == 0 || !game_running) {
+            break;
+        }
         
-        lock.unlock();
+        PhaseTimer timer(metrics, TickPhase::BattleResolve);
+        for (const auto& task : batch) {
+            processBattle(task);
+        }
+        total_battles += static_cast<int>(batch.size());
+    }
+    
+    safePrint("Battle thread stopped");
+}
+
+void GameManager::displayWorker() {
+    Trace::setThreadName("display");
+    safePrint("Display thread started");
+    
+    //       
+    TerminalRenderer renderer(STDOUT_FILENO);
+    
+    while (game_running) {
+        auto start_time = std::chrono::steady_clock::now();
         
-        auto end_time = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        if (!renderFrame(renderer)) {
+            stop_signal.waitFor(std::chrono::milliseconds(100));
+            continue;
+        }
         
         //    
-        if (elapsed < std::chrono::seconds(1)) {
-            std::this_thread::sleep_for(std::chrono::seconds(1) - elapsed);
-        }
+        stop_signal.waitUntil(start_time + std::chrono::seconds(1));
     }
     
-    std::cout << std::endl; //    
+    {
+        std::lock_guard<std::mutex> cout_lock(cout_mutex);
+        std::cout.flush();
+        renderer.finish();
+    }
     safePrint("Display thread stopped");
 }
 
-void GameManager::printMap() const {
-    //   -        
-    const int DISPLAY_WIDTH = 40;
-    const int DISPLAY_HEIGHT = 10;
+bool GameManager::renderFrame(TerminalRenderer& renderer) {
+    const int BAR_WIDTH = 40;
     
-    std::vector<std::vector<char>> map(DISPLAY_HEIGHT, 
-                                       std::vector<char>(DISPLAY_WIDTH, '.'));
+    //  
+    int progress = 0;
+    if (config.game_duration > 0) {
+        progress = (game_time * BAR_WIDTH) / config.game_duration;
+    }
+    if (progress > BAR_WIDTH) progress = BAR_WIDTH;
     
-    //  NPC  
-    for (const auto& npc : npcs) {
-        if (npc->isAlive()) {
-            auto [x, y] = npc->getPosition();
-            int display_x = (x * DISPLAY_WIDTH) / MAP_WIDTH;
-            int display_y = (y * DISPLAY_HEIGHT) / MAP_HEIGHT;
-            
-            if (display_x >= 0 && display_x < DISPLAY_WIDTH &&
-                display_y >= 0 && display_y < DISPLAY_HEIGHT) {
-                
-                char symbol = '.';
-                std::string type = npc->getType();
-                
-                if (type == "Bear") symbol = 'B';
-                else if (type == "Werewolf") symbol = 'W';
-                else if (type == "Bandit") symbol = 'R';
-                
-                map[display_y][display_x] = symbol;
-            }
+    //   ;     
+    auto frame = snapshots.read();
+    if (!frame) return false;
+    
+    const auto& kind_counts = frame->alive_by_kind;
+    
+    //    
+    renderer.beginFrame();
+    
+    // 
+    renderer.addLine("=== Balagur Fate 3 - Real-time Simulation ===");
+    renderer.addLine() = "Time: " + std::to_string(game_time.load()) + "s / " + 
+                         std::to_string(config.game_duration) + "s";
+    renderer.addLine().assign(50, '=');
+    
+    // -
+    std::string& bar = renderer.addLine();
+    bar += '[';
+    bar.append(progress, '=');
+    bar.append(BAR_WIDTH - progress, '.');
+    bar += ']';
+    
+    // 
+    renderer.addLine();
+    renderer.addLine("Statistics:");
+    renderer.addLine() = "  Alive: " + std::to_string(frame->aliveCount()) + "/" + 
+                         std::to_string(frame->size()) +
+                         "  Battles: " + std::to_string(total_battles.load()) +
+                         "  Kills: " + std::to_string(total_kills.load()) +
+                         "  Queue: " + std::to_string(battle_queue.size()) +
+                         " (dup " + std::to_string(battle_queue.getDroppedDuplicates()) +
+                         ", drop " + std::to_string(battle_queue.getDroppedOverflow()) + ")";
+    renderer.addLine() = "  Bears: " + std::to_string(kind_counts[static_cast<int>(NPCKind::Bear)]) +
+                         "  Werewolves: " + std::to_string(kind_counts[static_cast<int>(NPCKind::Werewolf)]) +
+                         "  Bandits: " + std::to_string(kind_counts[static_cast<int>(NPCKind::Bandit)]);
+    
+    renderer.addLine().assign(50, '-');
+    
+    //     -  !
+    renderer.addLine("Real-time Map (only alive NPCs):");
+    drawMap(*frame, renderer);
+    
+    // 
+    renderer.addLine("Legend: B=Bear  W=Werewolf  R=Bandit");
+    renderer.addLine().assign(50, '=');
+    
+    {
+        PhaseTimer timer(metrics, TickPhase::Render);
+        renderer.compose();
+        
+        //         write
+        std::unique_lock<std::mutex> cout_lock(cout_mutex, std::try_to_lock);
+        if (!cout_lock.owns_lock()) {
+            TRACE_SCOPE("wait cout_mutex", "lock");
+            cout_lock.lock();
         }
+        std::cout.flush();
+        renderer.write();
     }
     
-    std::cout << "\nSimplified Map (40x10):\n";
-    std::cout << "  +";
-    for (int j = 0; j < DISPLAY_WIDTH; ++j) std::cout << "-";
-    std::cout << "+\n";
+    return true;
+}
+
+void GameManager::drawMap(const WorldFrame& frame, TerminalRenderer& renderer) const {
+    const int width = config.display_width;
+    const int height = config.display_height;
+    const size_t first_row = renderer.lineCount() + 2;
     
-    for (int i = 0; i < DISPLAY_HEIGHT; ++i) {
-        std::cout << "  |";
-        for (int j = 0; j < DISPLAY_WIDTH; ++j) {
-            std::cout << map[i][j];
-        }
-        std::cout << "|\n";
+    renderer.addLine();
+    renderer.addLine() = "Simplified Map (" + std::to_string(width) + "x" + 
+                         std::to_string(height) + "):";
+    
+    std::string& top = renderer.addLine();
+    top += "  +";
+    top.append(width, '-');
+    top += '+';
+    
+    //       
+    for (int i = 0; i < height; ++i) {
+        std::string& row = renderer.addLine();
+        row += "  |";
+        row.append(width, '.');
+        row += '|';
     }
     
-    std::cout << "  +";
-    for (int j = 0; j < DISPLAY_WIDTH; ++j) std::cout << "-";
-    std::cout << "+\n";
+    std::string& bottom = renderer.addLine();
+    bottom += "  +";
+    bottom.append(width, '-');
+    bottom += '+';
+    
+    //  NPC  ;     
+    for (size_t word = 0; word < frame.alive_bits.size(); ++word) {
+        uint64_t bits = frame.alive_bits[word];
+        while (bits != 0) {
+            uint32_t id = static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+            
+            int display_x = static_cast<int>(static_cast<int64_t>(frame.xs[id]) * width / config.map_width);
+            int display_y = static_cast<int>(static_cast<int64_t>(frame.ys[id]) * height / config.map_height);
+            
+            if (display_x >= 0 && display_x < width &&
+                display_y >= 0 && display_y < height) {
+                renderer.lineAt(first_row + 1 + display_y)[3 + display_x] = kindSymbol(frame.kind(id));
+            }
+        }
+    }
 }
 
 void GameManager::printStatistics() const {
-    std::shared_lock<std::shared_mutex> lock(npcs_mutex);
-    
     std::cout << "\n=== CURRENT STATISTICS ===" << std::endl;
     std::cout << "Time: " << game_time.load() << "s" << std::endl;
     std::cout << "Battles: " << total_battles.load() 
               << "  Kills: " << total_kills.load() 
               << "  Queue: " << battle_queue.size() << std::endl;
+    std::cout << "Queue drops: duplicates " << battle_queue.getDroppedDuplicates()
+              << "  overflow " << battle_queue.getDroppedOverflow() << std::endl;
     
-    int alive_count = 0;
-    std::map<std::string, int> type_counts;
-    std::map<std::string, int> dead_counts;
-    
-    for (const auto& npc : npcs) {
-        if (npc->isAlive()) {
-            alive_count++;
-            type_counts[npc->getType()]++;
-        } else {
-            dead_counts[npc->getType()]++;
-        }
-    }
+    auto frame = snapshots.read();
+    if (!frame) return;
     
-    std::cout << "\nAlive: " << alive_count << "/" << npcs.size() << std::endl;
-    for (const auto& type : {"Bear", "Werewolf", "Bandit"}) {
-        std::cout << type[0] << ":" << type_counts[type] 
-                  << "/" << dead_counts[type] << "  ";
+    std::cout << "\nAlive: " << frame->aliveCount() << "/" << frame->size() << std::endl;
+    for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        std::cout << kindName(static_cast<NPCKind>(kind))[0] << ":" << frame->alive_by_kind[kind] 
+                  << "/" << frame->dead_by_kind[kind] << "  ";
     }
     std::cout << std::endl;
 }
 
 void GameManager::printFinalReport() const {
-    std::shared_lock<std::shared_mutex> lock(npcs_mutex);
+    auto frame = snapshots.read();
+    if (!frame) return;
     
     std::cout << "\n\n" << std::string(50, '=') << std::endl;
     std::cout << "           FINAL REPORT" << std::endl;
     std::cout << std::string(50, '=') << std::endl;
     
-    std::cout << "Duration: " << game_time.load() << " seconds" << std::endl;
+    double seconds = std::chrono::duration<double>(stopped_at - started_at).count();
+    if (config.headless) {
+        //       
+        std::cout << "Ticks:    " << tick.load() << " in " << std::fixed << std::setprecision(3) 
+                  << seconds << " s (" << std::setprecision(1) 
+                  << (seconds > 0.0 ? tick.load() / seconds : 0.0) << " ticks/s)" << std::endl;
+    } else {
+        std::cout << "Duration: " << game_time.load() << " seconds" << std::endl;
+    }
     std::cout << "Battles:  " << total_battles.load() << std::endl;
     std::cout << "Kills:    " << total_kills.load() << std::endl;
     
-    int alive_count = 0;
-    std::map<std::string, int> type_counts;
-    std::map<std::string, int> dead_counts;
+    //    
+    double throughput = seconds > 0.0 ? total_battles.load() / seconds : 0.0;
+    if (config.scheduler == GameConfig::Scheduler::Jobs) {
+        std::cout << "Job workers: " << job_worker_count << "  Stolen: " << jobs_stolen;
+    } else if (config.scheduler == GameConfig::Scheduler::Regions) {
+        std::cout << "Regions: " << regions.size();
+    } else {
+        std::cout << "Battle workers: " << (config.headless ? 1 : battle_worker_count);
+    }
+    std::cout << "  Throughput: " << std::fixed << std::setprecision(1) 
+              << throughput << " battles/s" << std::endl;
     
-    for (const auto& npc : npcs) {
-        if (npc->isAlive()) {
-            alive_count++;
-            type_counts[npc->getType()]++;
-        } else {
-            dead_counts[npc->getType()]++;
-        }
+    //           
+    if (!config.headless && config.scheduler == GameConfig::Scheduler::Threads) {
+        std::cout << "Queue drops: duplicates " << battle_queue.getDroppedDuplicates()
+                  << "  overflow " << battle_queue.getDroppedOverflow() << std::endl;
     }
     
-    std::cout << "\nSurvivors: " << alive_count << "/" << npcs.size() 
+    //    
+    std::cout << "\nTick phases:" << std::endl;
+    metrics.printReport(std::cout);
+    
+    int alive_count = frame->aliveCount();
+    size_t total_count = frame->size();
+    
+    std::cout << "\nSurvivors: " << alive_count << "/" << total_count 
               << " (" << std::fixed << std::setprecision(1) 
-              << (alive_count * 100.0 / npcs.size()) << "%)" << std::endl;
+              << (total_count > 0 ? alive_count * 100.0 / total_count : 0.0) << "%)" << std::endl;
     std::cout << std::string(30, '-') << std::endl;
     
     //   
     std::cout << "Type      Alive/Dead  Survival" << std::endl;
     
-    for (const auto& type : {"Bear", "Werewolf", "Bandit"}) {
-        int alive = type_counts[type];
-        int dead = dead_counts[type];
+    for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        const char* type = kindName(static_cast<NPCKind>(kind));
+        int alive = frame->alive_by_kind[kind];
+        int dead = frame->dead_by_kind[kind];
         int total = alive + dead;
         double rate = total > 0 ? (alive * 100.0 / total) : 0.0;
         
@@ -378,20 +1118,19 @@ void GameManager::printFinalReport() const {
     std::cout << "\nTop 10 Survivors:" << std::endl;
     std::cout << std::string(30, '-') << std::endl;
     
-    int survivor_num = 0;
+    //      ,    
+    int survivor_num = alive_count;
     int printed = 0;
-    for (const auto& npc : npcs) {
-        if (npc->isAlive()) {
-            survivor_num++;
-            if (printed < 10) {
-                std::cout << survivor_num << ". " 
-                          << npc->getType().substr(0, 1) 
-                          << " " << npc->getName() 
-                          << " at (" << npc->getPosition().first 
-                          << "," << npc->getPosition().second << ")" 
-                          << std::endl;
-                printed++;
-            }
+    for (uint32_t id = 0; id < total_count && printed < 10; ++id) {
+        if (frame->isAlive(id)) {
+            printed++;
+            //    ,     
+            std::cout << printed << ". " 
+                      << kindSymbol(frame->kind(id)) 
+                      << " " << world.name(id) 
+                      << " at (" << frame->xs[id] 
+                      << "," << frame->ys[id] << ")" 
+                      << std::endl;
         }
     }
     
@@ -401,41 +1140,166 @@ void GameManager::printFinalReport() const {
         std::cout << "No survivors!" << std::endl;
     }
     
-    std::cout << "\nDetailed log saved to 'log.txt'" << std::endl;
+    std::cout << "\nDetailed log saved to '" << config.log_path << "'" << std::endl;
+    if (kill_log->getDropped() > 0) {
+        std::cout << "Log drops: " << kill_log->getDropped() 
+                  << " (writer fell behind, raise --log-capacity)" << std::endl;
+    }
 }
 
 void GameManager::addRandomNPCs(int count) {
-    npcs.clear();
+    facades.clear();
+    npc_pool.reset();
+    world.clear();
     
+    //   "Werewolf_NPC_1000000"   24 
+    world.reserve(count, static_cast<size_t>(count) * 24);
+    
+    //   :    ,   npcFacades()
     for (int i = 0; i < count; ++i) {
-        std::string name = "NPC_" + std::to_string(i + 1);
-        auto npc = NPCFactory::createRandomNPC(name, MAP_WIDTH, MAP_HEIGHT);
-        npcs.push_back(npc);
+        NPCFactory::spawnRandomNPC(world, static_cast<uint32_t>(i + 1), 
+                                   config.map_width, config.map_height);
+    }
+}
+
+void GameManager::loadWorld(const std::string& path) {
+    facades.clear();
+    npc_pool.reset();
+    WorldFile::load(path, world, config.map_width, config.map_height);
+    config.total_npcs = static_cast<int>(world.size());
+}
+
+const std::vector<std::shared_ptr<NPC>>& GameManager::npcFacades() {
+    if (facades.size() != world.size()) bindFacades();
+    return facades;
+}
+
+void GameManager::bindFacades() {
+    facades.clear();
+    npc_pool.reset();
+    
+    if (config.pooled_npcs) {
+        npc_pool = NPCPool::create(world);
+        NPCPool::facades(npc_pool, facades);
+        //     
+        for (auto& observer : observers) {
+            npc_pool->addObserver(observer);
+        }
+        return;
+    }
+    
+    facades.reserve(world.size());
+    for (uint32_t id = 0; id < world.size(); ++id) {
+        facades.push_back(NPCFactory::bindNPC(world, id));
+        for (auto& observer : observers) {
+            facades.back()->addObserver(observer);
+        }
     }
 }
 
-bool GameManager::checkCollision(const std::shared_ptr<NPC>& a, 
-                                const std::shared_ptr<NPC>& b) const {
-    if (!a->isAlive() || !b->isAlive()) return false;
+void GameManager::maybeWriteMetrics() {
+    if (config.metrics_path.empty()) return;
+    
+    auto now = std::chrono::steady_clock::now();
+    if (now - metrics_written_at < std::chrono::milliseconds(config.metrics_interval_ms)) return;
+    
+    writeMetrics();
+}
+
+void GameManager::writeMetrics() {
+    if (config.metrics_path.empty()) return;
+    metrics_written_at = std::chrono::steady_clock::now();
     
-    double distance = a->calculateDistance(b);
-    return distance <= a->getKillDistance() || distance <= b->getKillDistance();
+    //      ,     
+    std::string temp_path = config.metrics_path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+        if (!file) return;
+        
+        metrics.writePrometheus(file);
+        file << "# TYPE balagur_ticks_total counter\n"
+             << "balagur_ticks_total " << tick.load() << "\n"
+             << "# TYPE balagur_battles_total counter\n"
+             << "balagur_battles_total " << total_battles.load() << "\n"
+             << "# TYPE balagur_kills_total counter\n"
+             << "balagur_kills_total " << total_kills.load() << "\n"
+             << "# TYPE balagur_alive_npcs gauge\n"
+             << "balagur_alive_npcs " << countAliveNPCs() << "\n"
+             << "# TYPE balagur_battle_queue_depth gauge\n"
+             << "balagur_battle_queue_depth " << battle_queue.size() << "\n"
+             << "# TYPE balagur_battle_queue_dropped_total counter\n"
+             << "balagur_battle_queue_dropped_total{reason=\"duplicate\"} " 
+             << battle_queue.getDroppedDuplicates() << "\n"
+             << "balagur_battle_queue_dropped_total{reason=\"overflow\"} " 
+             << battle_queue.getDroppedOverflow() << "\n";
+        if (!file) return;
+    }
+    std::rename(temp_path.c_str(), config.metrics_path.c_str());
+}
+
+void GameManager::saveWorld(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(npcs_mutex);
+    WorldFile::save(world, config.map_width, config.map_height, path);
+    safePrint("World saved to '" + path + "'");
+}
+
+bool GameManager::checkCollision(uint32_t a, uint32_t b) const {
+    if (!world.isAlive(a) || !world.isAlive(b)) return false;
+    
+    int dx = world.x(b) - world.x(a);
+    int dy = world.y(b) - world.y(a);
+    int distance_sq = dx * dx + dy * dy;
+    int reach_a = kindKillDistance(world.kind(a));
+    int reach_b = kindKillDistance(world.kind(b));
+    return distance_sq <= reach_a * reach_a || distance_sq <= reach_b * reach_b;
 }
 
 void GameManager::processBattle(const BattleTask& task) {
-    if (!task.attacker->isAlive() || !task.defender->isAlive()) {
+    //   ,     
+    uint32_t attacker, defender;
+    if (!world.resolve(task.attacker, attacker) || !world.resolve(task.defender, defender)) {
+        return;
+    }
+    
+    //        ,
+    //       
+    size_t first = attacker % BATTLE_LOCK_STRIPES;
+    size_t second = defender % BATTLE_LOCK_STRIPES;
+    
+    std::unique_lock<std::mutex> first_lock(battle_locks[std::min(first, second)], std::try_to_lock);
+    std::unique_lock<std::mutex> second_lock;
+    if (first != second) {
+        second_lock = std::unique_lock<std::mutex>(battle_locks[std::max(first, second)], std::defer_lock);
+    }
+    
+    //    ;      
+    if (!first_lock.owns_lock() || (second_lock.mutex() && !second_lock.try_lock())) {
+        TRACE_SCOPE("wait battle stripe", "lock");
+        if (!first_lock.owns_lock()) first_lock.lock();
+        if (second_lock.mutex() && !second_lock.owns_lock()) second_lock.lock();
+    }
+    
+    if (!world.isAlive(attacker) || !world.isAlive(defender)) {
         return; //   NPC  
     }
     
-    resolveBattle(task.attacker, task.defender);
+    resolveBattle(attacker, defender, task.tick);
+}
+
+void GameManager::deliverKills() {
+    //      
+    auto started = std::chrono::steady_clock::now();
+    size_t delivered = kill_bus.deliver(world, observers);
+    if (delivered > 0) {
+        metrics.record(TickPhase::ObserverNotify, std::chrono::steady_clock::now() - started);
+    }
 }
 
-void GameManager::resolveBattle(std::shared_ptr<NPC> attacker, 
-                               std::shared_ptr<NPC> defender) {
+void GameManager::resolveBattle(uint32_t attacker, uint32_t defender, uint32_t battle_tick) {
     // ,     
-    if (!attacker->canKill(defender)) {
+    if (!kindCanKill(world.kind(attacker), world.kind(defender))) {
         //  
-        if (defender->canKill(attacker)) {
+        if (kindCanKill(world.kind(defender), world.kind(attacker))) {
             std::swap(attacker, defender);
         } else {
             //      -  
@@ -443,21 +1307,23 @@ void GameManager::resolveBattle(std::shared_ptr<NPC> attacker,
         }
     }
     
-    //  
-    int attack_roll = Dice::roll();
-    int defense_roll = Dice::roll();
+    //  ;       
+    int attack_roll = Dice::rollKeyed(6, battle_tick, attacker, RandomPurpose::Attack, defender);
+    int defense_roll = Dice::rollKeyed(6, battle_tick, defender, RandomPurpose::Defense, attacker);
     
-    if (attack_roll > defense_roll) {
-        // 
-        defender->setAlive(false);
-        attacker->notifyKill(defender);
+    //    ,     
+    if (attack_roll > defense_roll && world.kill(defender)) {
+        // ;       
+        kill_bus.publish(KillEvent{world.handle(attacker), world.handle(defender), battle_tick});
         total_kills++;
         
+        if (config.headless) return;
+        
         //    
         std::lock_guard<std::mutex> lock(cout_mutex);
-        std::cout << "\n[KILL] " << attacker->getType() << " " 
-                  << attacker->getName() << " -> " 
-                  << defender->getType() << " " << defender->getName()
+        std::cout << "\n[KILL] " << kindName(world.kind(attacker)) << " " 
+                  << world.name(attacker) << " -> " 
+                  << kindName(world.kind(defender)) << " " << world.name(defender)
                   << " (" << attack_roll << ">" << defense_roll << ")" 
                   << std::endl;
     }
@@ -470,19 +1336,9 @@ void GameManager::safePrint(const std::string& message) const {
 }
 
 int GameManager::countAliveNPCs() const {
-    int count = 0;
-    for (const auto& npc : npcs) {
-        if (npc->isAlive()) count++;
-    }
-    return count;
+    return world.stats().totalAlive();
 }
 
-std::map<std::string, int> GameManager::countNPCsByType() const {
-    std::map<std::string, int> counts;
-    for (const auto& npc : npcs) {
-        if (npc->isAlive()) {
-            counts[npc->getType()]++;
-        }
-    }
-    return counts;
+std::array<int, NPC_KIND_COUNT> GameManager::countNPCsByKind() const {
+    return world.stats().aliveByKind();
 }
\ No newline at end of file
@@ -3,45 +3,158 @@
 
 #include "../npc/npc.h"
 #include "../observer/observer.h"
+#include "../observer/kill_event_bus.h"
 #include "battle_queue.h"
+#include "spatial_grid.h"
+#include "world.h"
+#include "world_snapshot.h"
+#include "terminal_renderer.h"
+#include "tick_metrics.h"
+#include "game_config.h"
+#include "../utils/stop_signal.h"
 #include <vector>
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <shared_mutex>
 #include <condition_variable>
-#include <map>
-#include <set>
+#include <array>
 #include <chrono>
 
+class NPCPool;
+class JobSystem;
+class JobGraph;
+class Barrier;
+class FileObserver;
+
 class GameManager {
 private:
-    std::vector<std::shared_ptr<NPC>> npcs;
+    //   NPC   .      
+    //  (   kill_bus),   
+    //   npcFacades() -  ,    NPC
+    World world;
+    std::vector<std::shared_ptr<NPC>> facades;
+    
+    //     ;     
+    std::shared_ptr<NPCPool> npc_pool;
     mutable std::shared_mutex npcs_mutex;
     
+    //     ,     
+    SnapshotBuffer snapshots;
+    
     BattleQueue battle_queue;
+    SpatialGrid grid;
+    
+    //   :     
+    //   
+    struct CollisionBand {
+        std::vector<BattleTask> battles;
+        std::vector<uint32_t> hits;
+        std::vector<int> dist_sq;
+    };
+    CollisionBand collision_scratch;
     
     std::vector<std::shared_ptr<Observer>> observers;
     
+    //   :      
+    std::shared_ptr<FileObserver> kill_log;
+    
+    //         
+    KillEventBus kill_bus;
+    
     std::atomic<bool> game_running{false};
+    
+    //   ( , ,  )   ,
+    //    ,  - 
+    StopSignal stop_signal;
     std::atomic<int> game_time{0};
     std::atomic<int> total_battles{0};
     std::atomic<int> total_kills{0};
     
     std::thread movement_thread;
-    std::thread battle_thread;
+    std::vector<std::thread> battle_threads;
     std::thread display_thread;
     
-    static constexpr int MAP_WIDTH = 100;
-    static constexpr int MAP_HEIGHT = 100;
-    static constexpr int TOTAL_NPCS = 50;
-    static constexpr int GAME_DURATION = 30;
+    //   :    ,   
+    // (,   ,  , )   
+    std::unique_ptr<JobSystem> job_system;
+    std::unique_ptr<JobGraph> tick_graph;
+    std::thread scheduler_thread;
+    size_t move_node = 0;
+    size_t grid_node = 0;
+    size_t collide_node = 0;
+    std::vector<CollisionBand> collision_bands;
+    std::vector<BattleTask> job_battles;
+    std::unique_ptr<TerminalRenderer> job_renderer;
+    std::atomic<bool> render_pending{false};
+    int job_worker_count = 0;
+    uint64_t jobs_stolen = 0;
+    
+    //  :     ,   
+    //     NPC;      NPC
+    // ()   ,    
+    struct Region {
+        int left = 0;                                   //  [left, right)  x
+        int right = 0;
+        std::vector<uint32_t> owned;                    //   NPC
+        std::vector<std::vector<uint32_t>> migrants;    // ,    
+        std::vector<std::vector<uint32_t>> ghosts;      //  NPC,   
+        SpatialGrid grid;                               //  NPC   
+        CollisionBand scratch;
+        std::vector<BattleTask> local_battles;          //   
+        std::vector<BattleTask> cross_battles;          //     
+    };
+    std::vector<std::unique_ptr<Region>> regions;
+    std::vector<std::thread> region_threads;
+    std::unique_ptr<Barrier> region_barrier;
+    int region_width = 1;
+    std::atomic<bool> regions_stopping{false};
+    
+    //  ;     
+    // (tick, id),        
+    int movement_threads = 1;
+    std::atomic<uint32_t> tick{0};
+    
+    //   ;     ,
+    //     ,    
+    std::vector<std::thread> move_workers;
+    std::unique_ptr<Barrier> move_barrier;
+    std::vector<int> move_counts;
+    uint32_t move_total = 0;
+    uint32_t move_chunk = 0;
+    uint32_t move_pass_tick = 0;
+    bool move_stopping = false;
+    
+    //   ;    NPC    
+    int battle_worker_count = 1;
+    static constexpr size_t BATTLE_BATCH_SIZE = 64;
+    static constexpr size_t BATTLE_LOCK_STRIPES = 256;
+    std::array<std::mutex, BATTLE_LOCK_STRIPES> battle_locks;
+    
+    //       
+    std::chrono::steady_clock::time_point started_at;
+    std::chrono::steady_clock::time_point stopped_at;
+    
+    GameConfig config;
+    
+    //   ;      
+    TickMetrics metrics;
+    std::chrono::steady_clock::time_point metrics_written_at;
+    
+    //    NPC     
+    static constexpr uint32_t MIN_MOVE_CHUNK = 4096;
     
     //   std::cout
     static std::mutex cout_mutex;
     
+    //     
+    friend class GameBench;
+    
+    // -   ,   ,   
+    friend class ShardNode;
+    
 public:
-    GameManager();
+    explicit GameManager(const GameConfig& config = GameConfig());
     ~GameManager();
     
     // 
@@ -50,27 +163,82 @@ public:
     void stop();
     void run();
     
+    //  run()  ;    
+    void requestStop();
+    
+    //   config.ticks   
+    void runHeadless();
+    
+    //     (0 -   )
+    void setMovementThreads(int count);
+    
+    //     (0 -   )
+    void setBattleThreads(int count);
+    
     void printStatistics() const;
     void printFinalReport() const;
     
+    //       
+    void saveWorld(const std::string& path) const;
+    
+    //  NPC   ;     ( 
+    //     --no-pool)     .
+    // ,    
+    const std::vector<std::shared_ptr<NPC>>& npcFacades();
+    
 private:
     //
     void movementWorker();
     void battleWorker();
     void displayWorker();
+    void schedulerWorker();
+    void regionWorker(size_t index);
+    void moveWorker(uint32_t index);
     
     //
-    void printMap() const;
+    void moveOne(uint32_t id, uint32_t move_tick);
+    int moveRange(uint32_t begin, uint32_t end, uint32_t move_tick);
+    int moveAll();
+    void startMoveWorkers(uint32_t workers);
+    void stopMoveWorkers();
+    void rebuildGrid();
+    int detectCollisions(uint32_t collision_tick, std::vector<BattleTask>& out);
+    int detectCollisionRows(int row_begin, int row_end, uint32_t collision_tick,
+                            std::vector<BattleTask>& out, CollisionBand& scratch);
+    template <typename Fn>
+    int forEachKillPair(const SpatialGrid& pairs_grid, int row_begin, int row_end,
+                        CollisionBand& scratch, Fn&& fn) const;
+    void appendBattle(uint32_t a, uint32_t b, int distance, uint32_t battle_tick,
+                      std::vector<BattleTask>& out) const;
+    void stepTick(std::vector<BattleTask>& tick_battles);
+    void startJobs();
+    void stopJobs();
+    void buildTickGraph();
+    void runTickGraph();
+    bool renderFrame(TerminalRenderer& renderer);
+    void startRegions();
+    void joinRegions();
+    size_t regionOf(int x) const;
+    void moveRegion(size_t index, uint32_t move_tick);
+    void collideRegion(size_t index, uint32_t collision_tick);
+    void collideStrip(const SpatialGrid& strip_grid, CollisionBand& scratch, size_t index,
+                      int strip_width, size_t strip_count, uint32_t collision_tick,
+                      std::vector<BattleTask>& local, std::vector<BattleTask>& cross) const;
+    void resolveRegionBattles(const std::vector<BattleTask>& tasks);
+    void drawMap(const WorldFrame& frame, TerminalRenderer& renderer) const;
     void addRandomNPCs(int count);
-    bool checkCollision(const std::shared_ptr<NPC>& a, 
-                       const std::shared_ptr<NPC>& b) const;
+    void loadWorld(const std::string& path);
+    void maybeWriteMetrics();
+    void writeMetrics();
+    void bindFacades();
+    bool checkCollision(uint32_t a, uint32_t b) const;
     void processBattle(const BattleTask& task);
-    void resolveBattle(std::shared_ptr<NPC> attacker, 
-                      std::shared_ptr<NPC> defender);
+    void deliverKills();
+    void resolveBattle(uint32_t attacker, uint32_t defender, uint32_t battle_tick);
     
     void safePrint(const std::string& message) const;
     int countAliveNPCs() const;
-    std::map<std::string, int> countNPCsByType() const;
+    std::array<int, NPC_KIND_COUNT> countNPCsByKind() const;
 };
 
 #endif
\ No newline at end of file
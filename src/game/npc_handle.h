@@ -0,0 +1,40 @@
+#ifndef NPC_HANDLE_H
+#define NPC_HANDLE_H
+
+#include <cstdint>
+
+// 32-   NPC:      .
+//  ,     ,  
+//         NPC
+class NPCHandle {
+public:
+    static constexpr uint32_t SLOT_BITS = 24;
+    static constexpr uint32_t MAX_SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = MAX_SLOTS - 1;
+    static constexpr uint32_t GENERATION_MASK = 0xFFu;
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+    constexpr NPCHandle() : value(INVALID) {}
+
+    static constexpr NPCHandle make(uint32_t slot, uint32_t generation) {
+        return NPCHandle(((generation & GENERATION_MASK) << SLOT_BITS) | (slot & SLOT_MASK));
+    }
+
+    constexpr uint32_t slot() const { return value & SLOT_MASK; }
+    constexpr uint32_t generation() const { return value >> SLOT_BITS; }
+    constexpr uint32_t raw() const { return value; }
+    constexpr bool isValid() const { return value != INVALID; }
+
+    constexpr bool operator==(NPCHandle other) const { return value == other.value; }
+    constexpr bool operator!=(NPCHandle other) const { return value != other.value; }
+    constexpr bool operator<(NPCHandle other) const { return value < other.value; }
+
+private:
+    uint32_t value;
+
+    explicit constexpr NPCHandle(uint32_t value) : value(value) {}
+};
+
+static_assert(sizeof(NPCHandle) == 4, "handle must stay 32-bit");
+
+#endif
\ No newline at end of file
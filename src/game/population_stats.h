@@ -0,0 +1,79 @@
+#ifndef POPULATION_STATS_H
+#define POPULATION_STATS_H
+
+#include "../npc/npc_kind.h"
+#include <atomic>
+#include <array>
+
+//      .    
+//   NPC,    - O(1)   
+class PopulationStats {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    //     -:       
+    struct alignas(CACHE_LINE) KindCounters {
+        std::atomic<int> alive{0};
+        std::atomic<int> dead{0};
+    };
+
+    std::array<KindCounters, NPC_KIND_COUNT> counters;
+
+    static int index(NPCKind kind) { return static_cast<int>(kind); }
+
+public:
+    void reset() {
+        for (auto& counter : counters) {
+            counter.alive.store(0, std::memory_order_relaxed);
+            counter.dead.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void onSpawn(NPCKind kind) {
+        counters[index(kind)].alive.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void onDeath(NPCKind kind) {
+        counters[index(kind)].alive.fetch_sub(1, std::memory_order_relaxed);
+        counters[index(kind)].dead.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void onRevive(NPCKind kind) {
+        counters[index(kind)].dead.fetch_sub(1, std::memory_order_relaxed);
+        counters[index(kind)].alive.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int alive(NPCKind kind) const {
+        return counters[index(kind)].alive.load(std::memory_order_relaxed);
+    }
+
+    int dead(NPCKind kind) const {
+        return counters[index(kind)].dead.load(std::memory_order_relaxed);
+    }
+
+    int totalAlive() const {
+        int total = 0;
+        for (const auto& counter : counters) {
+            total += counter.alive.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    int totalDead() const {
+        int total = 0;
+        for (const auto& counter : counters) {
+            total += counter.dead.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    std::array<int, NPC_KIND_COUNT> aliveByKind() const {
+        std::array<int, NPC_KIND_COUNT> result{};
+        for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+            result[kind] = counters[kind].alive.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+};
+
+#endif
\ No newline at end of file
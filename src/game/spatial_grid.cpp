@@ -0,0 +1,68 @@
+#include "spatial_grid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(int map_width, int map_height, int cell_size) {
+    configure(map_width, map_height, cell_size);
+}
+
+void SpatialGrid::configure(int width, int height, int size) {
+    map_width = std::max(1, width);
+    map_height = std::max(1, height);
+    cell_size = std::max(1, size);
+    cols = (map_width + cell_size - 1) / cell_size;
+    rows = (map_height + cell_size - 1) / cell_size;
+
+    cell_start.assign(static_cast<size_t>(cols) * rows + 1, 0);
+    clear();
+}
+
+void SpatialGrid::clear() {
+    staging.clear();
+    staging_cell.clear();
+    item_ids.clear();
+    item_xs.clear();
+    item_ys.clear();
+    item_reach_sq.clear();
+    std::fill(cell_start.begin(), cell_start.end(), 0);
+}
+
+int SpatialGrid::cellX(int x) const {
+    return std::max(0, std::min(cols - 1, x / cell_size));
+}
+
+int SpatialGrid::cellY(int y) const {
+    return std::max(0, std::min(rows - 1, y / cell_size));
+}
+
+void SpatialGrid::insert(uint32_t id, int x, int y, int reach_sq) {
+    staging.push_back({id, x, y, reach_sq});
+    staging_cell.push_back(static_cast<uint32_t>(cellY(y) * cols + cellX(x)));
+}
+
+void SpatialGrid::build() {
+    std::fill(cell_start.begin(), cell_start.end(), 0);
+
+    //     
+    for (uint32_t cell : staging_cell) {
+        cell_start[cell + 1]++;
+    }
+
+    //      
+    for (size_t i = 1; i < cell_start.size(); ++i) {
+        cell_start[i] += cell_start[i - 1];
+    }
+
+    //    
+    item_ids.resize(staging.size());
+    item_xs.resize(staging.size());
+    item_ys.resize(staging.size());
+    item_reach_sq.resize(staging.size());
+    cursor.assign(cell_start.begin(), cell_start.end() - 1);
+    for (size_t i = 0; i < staging.size(); ++i) {
+        uint32_t index = cursor[staging_cell[i]]++;
+        item_ids[index] = staging[i].id;
+        item_xs[index] = staging[i].x;
+        item_ys[index] = staging[i].y;
+        item_reach_sq[index] = staging[i].reach_sq;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+//     :    
+//   ,   
+//   
+class SpatialGrid {
+public:
+    struct Item {
+        uint32_t id;
+        int x;
+        int y;
+        int reach_sq;   //   
+    };
+
+private:
+    int map_width = 0;
+    int map_height = 0;
+    int cell_size = 1;
+    int cols = 1;
+    int rows = 1;
+
+    std::vector<Item> staging;          //   
+    std::vector<uint32_t> staging_cell; //   
+    std::vector<uint32_t> cell_start;   //     (rows*cols+1)
+    
+    // ,   ,   ,
+    //        
+    std::vector<uint32_t> item_ids;
+    std::vector<int> item_xs;
+    std::vector<int> item_ys;
+    std::vector<int> item_reach_sq;
+    std::vector<uint32_t> cursor;       //    
+
+public:
+    SpatialGrid() = default;
+    SpatialGrid(int map_width, int map_height, int cell_size);
+
+    //     
+    void configure(int map_width, int map_height, int cell_size);
+
+    //   
+    void clear();
+
+    //   (  )
+    void insert(uint32_t id, int x, int y, int reach_sq = 0);
+
+    //     (counting sort)
+    void build();
+
+    int getCellSize() const { return cell_size; }
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    size_t size() const { return item_ids.size(); }
+
+    const uint32_t* ids() const { return item_ids.data(); }
+    const int* xs() const { return item_xs.data(); }
+    const int* ys() const { return item_ys.data(); }
+    const int* reachSq() const { return item_reach_sq.data(); }
+
+    Item item(uint32_t index) const {
+        return {item_ids[index], item_xs[index], item_ys[index], item_reach_sq[index]};
+    }
+
+    //      
+    uint32_t cellBegin(int cx, int cy) const { return cell_start[cy * cols + cx]; }
+    uint32_t cellEnd(int cx, int cy) const { return cell_start[cy * cols + cx + 1]; }
+
+    //          
+    //  , : fn(index, begin, end)  
+    //      [begin, end)  
+    template <typename Fn>
+    void forEachCandidateRun(Fn&& fn) const { forEachCandidateRun(0, rows, fn); }
+
+    //      [row_begin, row_end);  
+    //   ,     
+    template <typename Fn>
+    void forEachCandidateRun(int row_begin, int row_end, Fn&& fn) const;
+
+private:
+    int cellX(int x) const;
+    int cellY(int y) const;
+};
+
+template <typename Fn>
+void SpatialGrid::forEachCandidateRun(int row_begin, int row_end, Fn&& fn) const {
+    //  :     ,   
+    //     .    
+    // :         
+    //   ,       
+    for (int cy = std::max(0, row_begin); cy < std::min(rows, row_end); ++cy) {
+        for (int cx = 0; cx < cols; ++cx) {
+            uint32_t begin = cellBegin(cx, cy);
+            uint32_t end = cellEnd(cx, cy);
+            if (begin == end) continue;
+
+            uint32_t right_end = cx + 1 < cols ? cellEnd(cx + 1, cy) : end;
+            uint32_t below_begin = 0;
+            uint32_t below_end = 0;
+            if (cy + 1 < rows) {
+                below_begin = cellBegin(std::max(cx - 1, 0), cy + 1);
+                below_end = cellEnd(std::min(cx + 1, cols - 1), cy + 1);
+            }
+
+            for (uint32_t a = begin; a != end; ++a) {
+                if (a + 1 < right_end) fn(a, a + 1, right_end);
+                if (below_begin < below_end) fn(a, below_begin, below_end);
+            }
+        }
+    }
+}
+
+#endif
\ No newline at end of file
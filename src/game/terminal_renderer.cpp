@@ -0,0 +1,102 @@
+#include "terminal_renderer.h"
+#include <unistd.h>
+#include <cerrno>
+
+TerminalRenderer::TerminalRenderer(int fd)
+    : fd(fd), is_terminal(fd >= 0 && ::isatty(fd)) {
+    output.reserve(4096);
+}
+
+void TerminalRenderer::beginFrame() {
+    line_count = 0;
+}
+
+std::string& TerminalRenderer::addLine() {
+    if (line_count == lines.size()) {
+        lines.emplace_back();
+    }
+    std::string& line = lines[line_count++];
+    line.clear();
+    return line;
+}
+
+void TerminalRenderer::addLine(std::string_view text) {
+    addLine().assign(text.data(), text.size());
+}
+
+void TerminalRenderer::appendCursor(size_t row) {
+    output += "\033[";
+    output += std::to_string(row + 1);
+    output += ";1H";
+}
+
+const std::string& TerminalRenderer::compose() {
+    output.clear();
+    
+    if (!is_terminal) {
+        //   :  ,   
+        for (size_t i = 0; i < line_count; ++i) {
+            output += lines[i];
+            output += '\n';
+        }
+    } else if (first_frame || line_count != previous_count) {
+        //     :    
+        //       
+        output += "\033[r\033[2J\033[H";
+        for (size_t i = 0; i < line_count; ++i) {
+            output += lines[i];
+            output += "\033[K\n";
+        }
+        output += "\033[";
+        output += std::to_string(line_count + 1);
+        output += ";r";
+        appendCursor(line_count);
+        first_frame = false;
+    } else {
+        //  :       
+        output += "\0337";
+        for (size_t i = 0; i < line_count; ++i) {
+            if (lines[i] == previous[i]) continue;
+            appendCursor(i);
+            output += lines[i];
+            output += "\033[K";
+        }
+        output += "\0338";
+    }
+    
+    //    ;     
+    if (previous.size() < line_count) previous.resize(line_count);
+    for (size_t i = 0; i < line_count; ++i) {
+        previous[i].swap(lines[i]);
+    }
+    previous_count = line_count;
+    
+    return output;
+}
+
+void TerminalRenderer::write() {
+    const char* data = output.data();
+    size_t left = output.size();
+    
+    //    ;   
+    while (left > 0 && fd >= 0) {
+        ssize_t written = ::write(fd, data, left);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+    output.clear();
+}
+
+void TerminalRenderer::finish() {
+    if (is_terminal && !first_frame) {
+        output = "\033[r";
+        appendCursor(999);
+        output += '\n';
+        write();
+    }
+    first_frame = true;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef TERMINAL_RENDERER_H
+#define TERMINAL_RENDERER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+//      .   
+//   ,     ,
+//        -   write.
+//     ,    
+//   .    ,    
+//  
+class TerminalRenderer {
+private:
+    int fd;
+    bool is_terminal;
+
+    std::vector<std::string> lines;
+    std::vector<std::string> previous;
+    size_t line_count = 0;
+    size_t previous_count = 0;
+    bool first_frame = true;
+
+    std::string output;
+
+    void appendCursor(size_t row);
+
+public:
+    explicit TerminalRenderer(int fd);
+
+    TerminalRenderer(const TerminalRenderer&) = delete;
+    TerminalRenderer& operator=(const TerminalRenderer&) = delete;
+
+    //   ;     
+    void beginFrame();
+
+    //   , ,     
+    std::string& addLine();
+    void addLine(std::string_view text);
+
+    size_t lineCount() const { return line_count; }
+    std::string& lineAt(size_t index) { return lines[index]; }
+
+    //        
+    const std::string& compose();
+
+    //       
+    void write();
+
+    //        
+    void finish();
+
+    //    
+    void invalidate() { first_frame = true; }
+};
+
+#endif
\ No newline at end of file
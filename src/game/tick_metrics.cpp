@@ -0,0 +1,63 @@
+#include "tick_metrics.h"
+#include <iomanip>
+
+const char* TickMetrics::phaseName(TickPhase phase) {
+    switch (phase) {
+        case TickPhase::Move: return "move";
+        case TickPhase::Collision: return "collision";
+        case TickPhase::Enqueue: return "enqueue";
+        case TickPhase::BattleResolve: return "battle_resolve";
+        case TickPhase::ObserverNotify: return "observer_notify";
+        case TickPhase::Render: return "render";
+    }
+    return "unknown";
+}
+
+void TickMetrics::reset() {
+    for (auto& histogram : phases) {
+        histogram.reset();
+    }
+}
+
+void TickMetrics::printReport(std::ostream& out) const {
+    out << "Phase            Count      p50 us      p99 us      max us" << std::endl;
+    
+    for (int i = 0; i < TICK_PHASE_COUNT; ++i) {
+        const LatencyHistogram& histogram = phases[i];
+        if (histogram.count() == 0) continue;
+        
+        out << std::left << std::setw(15) << phaseName(static_cast<TickPhase>(i))
+            << std::right << std::setw(7) << histogram.count()
+            << std::fixed << std::setprecision(1)
+            << std::setw(12) << histogram.percentile(0.50) / 1000.0
+            << std::setw(12) << histogram.percentile(0.99) / 1000.0
+            << std::setw(12) << histogram.getMax() / 1000.0 << std::endl;
+    }
+}
+
+void TickMetrics::writePrometheus(std::ostream& out) const {
+    out << "# HELP balagur_phase_seconds Duration of simulation tick phases.\n"
+        << "# TYPE balagur_phase_seconds summary\n";
+    
+    out << std::setprecision(9);
+    for (int i = 0; i < TICK_PHASE_COUNT; ++i) {
+        const LatencyHistogram& histogram = phases[i];
+        const char* name = phaseName(static_cast<TickPhase>(i));
+        
+        for (double q : {0.5, 0.99}) {
+            out << "balagur_phase_seconds{phase=\"" << name << "\",quantile=\"" << q << "\"} "
+                << histogram.percentile(q) * 1e-9 << "\n";
+        }
+        out << "balagur_phase_seconds_sum{phase=\"" << name << "\"} " 
+            << histogram.getSum() * 1e-9 << "\n";
+        out << "balagur_phase_seconds_count{phase=\"" << name << "\"} " 
+            << histogram.count() << "\n";
+    }
+    
+    out << "# HELP balagur_phase_max_seconds Longest observed duration of a tick phase.\n"
+        << "# TYPE balagur_phase_max_seconds gauge\n";
+    for (int i = 0; i < TICK_PHASE_COUNT; ++i) {
+        out << "balagur_phase_max_seconds{phase=\"" << phaseName(static_cast<TickPhase>(i)) 
+            << "\"} " << phases[i].getMax() * 1e-9 << "\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef TICK_METRICS_H
+#define TICK_METRICS_H
+
+#include "../utils/latency_histogram.h"
+#include "../utils/trace.h"
+#include <array>
+#include <chrono>
+#include <string>
+#include <ostream>
+
+//  ,     
+enum class TickPhase : uint8_t {
+    Move,           //   NPC
+    Collision,      //     
+    Enqueue,        //    
+    BattleResolve,  //    
+    ObserverNotify, //     
+    Render          //      
+};
+
+constexpr int TICK_PHASE_COUNT = 6;
+
+class TickMetrics {
+private:
+    std::array<LatencyHistogram, TICK_PHASE_COUNT> phases;
+
+public:
+    static const char* phaseName(TickPhase phase);
+
+    void record(TickPhase phase, std::chrono::steady_clock::duration elapsed) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        phases[static_cast<int>(phase)].record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+    }
+
+    const LatencyHistogram& histogram(TickPhase phase) const {
+        return phases[static_cast<int>(phase)];
+    }
+
+    void reset();
+
+    //  p50/p99/max     
+    void printReport(std::ostream& out) const;
+
+    //     Prometheus
+    void writePrometheus(std::ostream& out) const;
+};
+
+//        
+class PhaseTimer {
+private:
+    TickMetrics& metrics;
+    TickPhase phase;
+    std::chrono::steady_clock::time_point started;
+
+public:
+    PhaseTimer(TickMetrics& metrics, TickPhase phase)
+        : metrics(metrics), phase(phase), started(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() {
+        auto finished = std::chrono::steady_clock::now();
+        metrics.record(phase, finished - started);
+        
+        if (Trace::enabled()) {
+            Trace::complete(TickMetrics::phaseName(phase), "tick", started, finished);
+        }
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "world.h"
+#include <algorithm>
+#include <stdexcept>
+#include <charconv>
+
+void World::growAliveBits(size_t count) {
+    size_t needed = (count + 63) / 64;
+    if (needed <= alive_words) return;
+
+    //  ,     O(1)
+    size_t new_words = std::max(needed, alive_words * 2);
+    std::unique_ptr<std::atomic<uint64_t>[]> bits(new std::atomic<uint64_t>[new_words]);
+    for (size_t i = 0; i < new_words; ++i) {
+        uint64_t value = i < alive_words ? alive_bits[i].load(std::memory_order_relaxed) : 0;
+        bits[i].store(value, std::memory_order_relaxed);
+    }
+
+    alive_bits = std::move(bits);
+    alive_words = new_words;
+}
+
+uint32_t World::addSlot(NPCKind kind, int x, int y) {
+    if (kinds.size() >= NPCHandle::MAX_SLOTS) {
+        throw std::length_error("World is full: NPC handles address at most 2^24 slots");
+    }
+    uint32_t id = static_cast<uint32_t>(kinds.size());
+
+    xs.push_back(x);
+    ys.push_back(y);
+    kinds.push_back(kind);
+    generations.push_back(0);
+
+    growAliveBits(kinds.size());
+    alive_bits[id >> 6].fetch_or(uint64_t(1) << (id & 63), std::memory_order_acq_rel);
+    population.onSpawn(kind);
+
+    return id;
+}
+
+uint32_t World::add(NPCKind kind, std::string_view name, int x, int y) {
+    uint32_t id = addSlot(kind, x, y);
+
+    name_chars.insert(name_chars.end(), name.begin(), name.end());
+    name_offsets.push_back(static_cast<uint32_t>(name_chars.size()));
+
+    return id;
+}
+
+uint32_t World::addNumbered(NPCKind kind, std::string_view prefix, uint64_t number, int x, int y) {
+    uint32_t id = addSlot(kind, x, y);
+
+    //   :      
+    char digits[20];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    name_chars.insert(name_chars.end(), prefix.begin(), prefix.end());
+    name_chars.insert(name_chars.end(), digits, result.ptr);
+    name_offsets.push_back(static_cast<uint32_t>(name_chars.size()));
+
+    return id;
+}
+
+void World::reserve(size_t count, size_t name_bytes) {
+    xs.reserve(count);
+    ys.reserve(count);
+    kinds.reserve(count);
+    generations.reserve(count);
+    name_offsets.reserve(count + 1);
+    name_chars.reserve(name_bytes);
+    growAliveBits(count);
+}
+
+void World::clear() {
+    xs.clear();
+    ys.clear();
+    kinds.clear();
+    generations.clear();
+    name_chars.clear();
+    name_offsets.assign(1, 0);
+    for (size_t i = 0; i < alive_words; ++i) {
+        alive_bits[i].store(0, std::memory_order_relaxed);
+    }
+    population.reset();
+}
+
+void World::setAlive(uint32_t id, bool is_alive) {
+    uint64_t mask = uint64_t(1) << (id & 63);
+    if (is_alive) {
+        //  ,     
+        uint64_t previous = alive_bits[id >> 6].fetch_or(mask, std::memory_order_acq_rel);
+        if ((previous & mask) == 0) {
+            //   :     
+            generations[id] = static_cast<uint8_t>(generations[id] + 1);
+            population.onRevive(kinds[id]);
+        }
+    } else {
+        kill(id);
+    }
+}
+
+bool World::kill(uint32_t id) {
+    uint64_t mask = uint64_t(1) << (id & 63);
+    uint64_t previous = alive_bits[id >> 6].fetch_and(~mask, std::memory_order_acq_rel);
+    if ((previous & mask) == 0) return false;
+    
+    population.onDeath(kinds[id]);
+    return true;
+}
+
+size_t World::countAlive() const {
+    size_t count = 0;
+    for (size_t i = 0; i < alive_words; ++i) {
+        count += __builtin_popcountll(alive_bits[i].load(std::memory_order_relaxed));
+    }
+    return count;
+}
+
+void World::assign(size_t count, const NPCKind* kinds_data, const int* xs_data, const int* ys_data,
+                   const uint64_t* alive_data, const uint32_t* name_offsets_data,
+                   const char* name_chars_data, size_t name_chars_size) {
+    clear();
+    
+    xs.assign(xs_data, xs_data + count);
+    ys.assign(ys_data, ys_data + count);
+    kinds.assign(kinds_data, kinds_data + count);
+    generations.assign(count, 0);
+    name_offsets.assign(name_offsets_data, name_offsets_data + count + 1);
+    name_chars.assign(name_chars_data, name_chars_data + name_chars_size);
+    
+    growAliveBits(count);
+    size_t words = (count + 63) / 64;
+    for (size_t i = 0; i < words; ++i) {
+        alive_bits[i].store(alive_data[i], std::memory_order_relaxed);
+    }
+    //        
+    if (count % 64 != 0) {
+        alive_bits[words - 1].fetch_and((uint64_t(1) << (count % 64)) - 1, std::memory_order_relaxed);
+    }
+    
+    //      
+    for (uint32_t id = 0; id < count; ++id) {
+        population.onSpawn(kinds[id]);
+        if (!isAlive(id)) population.onDeath(kinds[id]);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
\ No newline at end of file
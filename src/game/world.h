@@ -0,0 +1,117 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "../npc/npc_kind.h"
+#include "population_stats.h"
+#include "npc_handle.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+//      :  
+// (, ,  )     ,
+//  () -    
+class World {
+private:
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<NPCKind> kinds;
+    
+    //  : ,     
+    std::vector<uint8_t> generations;
+
+    //    NPC,       
+    std::unique_ptr<std::atomic<uint64_t>[]> alive_bits;
+    size_t alive_words = 0;
+
+    // :        
+    std::vector<char> name_chars;
+    std::vector<uint32_t> name_offsets{0};
+
+    //   ,     
+    PopulationStats population;
+
+    void growAliveBits(size_t count);
+    uint32_t addSlot(NPCKind kind, int x, int y);
+
+public:
+    World() = default;
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    //  NPC,   
+    uint32_t add(NPCKind kind, std::string_view name, int x, int y);
+    
+    //  ,   prefix + number     
+    uint32_t addNumbered(NPCKind kind, std::string_view prefix, uint64_t number, int x, int y);
+    
+    //     
+    NPCHandle handle(uint32_t id) const { return NPCHandle::make(id, generations[id]); }
+    
+    //     ; false -    
+    bool resolve(NPCHandle handle, uint32_t& id) const {
+        if (!handle.isValid() || handle.slot() >= kinds.size()) return false;
+        if (generations[handle.slot()] != handle.generation()) return false;
+        id = handle.slot();
+        return true;
+    }
+
+    // name_bytes -    
+    void reserve(size_t count, size_t name_bytes = 0);
+    void clear();
+
+    size_t size() const { return kinds.size(); }
+
+    int x(uint32_t id) const { return xs[id]; }
+    int y(uint32_t id) const { return ys[id]; }
+    void setPosition(uint32_t id, int x, int y) { xs[id] = x; ys[id] = y; }
+
+    int* xData() { return xs.data(); }
+    int* yData() { return ys.data(); }
+    const int* xData() const { return xs.data(); }
+    const int* yData() const { return ys.data(); }
+
+    NPCKind kind(uint32_t id) const { return kinds[id]; }
+    const NPCKind* kindData() const { return kinds.data(); }
+
+    std::string_view name(uint32_t id) const {
+        return std::string_view(name_chars.data() + name_offsets[id],
+                                name_offsets[id + 1] - name_offsets[id]);
+    }
+
+    bool isAlive(uint32_t id) const {
+        return (alive_bits[id >> 6].load(std::memory_order_acquire) >> (id & 63)) & 1u;
+    }
+
+    //    ,    
+    void setAlive(uint32_t id, bool is_alive);
+
+    //    ; true   ,   
+    bool kill(uint32_t id);
+
+    //   (popcount  )
+    size_t countAlive() const;
+    
+    //       O(1)
+    const PopulationStats& stats() const { return population; }
+    
+    //       
+    size_t aliveWordCount() const { return (size() + 63) / 64; }
+    uint64_t aliveWord(size_t index) const {
+        return alive_bits[index].load(std::memory_order_acquire);
+    }
+    const uint32_t* nameOffsetsData() const { return name_offsets.data(); }
+    const char* nameCharsData() const { return name_chars.data(); }
+    size_t nameCharsSize() const { return name_chars.size(); }
+    
+    //      (,   )
+    void assign(size_t count, const NPCKind* kinds_data, const int* xs_data, const int* ys_data,
+                const uint64_t* alive_data, const uint32_t* name_offsets_data,
+                const char* name_chars_data, size_t name_chars_size);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "world_file.h"
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+uint64_t alignUp(uint64_t value) {
+    return (value + WorldFile::SECTION_ALIGN - 1) & ~(WorldFile::SECTION_ALIGN - 1);
+}
+
+//    ,    
+WorldFileHeader makeHeader(const World& world, int map_width, int map_height) {
+    WorldFileHeader header{};
+    std::memcpy(header.magic, WorldFile::MAGIC, sizeof(header.magic));
+    header.version = WorldFile::VERSION;
+    header.byte_order = WorldFile::ENDIAN_MARK;
+    header.count = world.size();
+    header.map_width = map_width;
+    header.map_height = map_height;
+    header.name_chars_size = world.nameCharsSize();
+
+    uint64_t count = header.count;
+    uint64_t offset = alignUp(sizeof(WorldFileHeader));
+    header.kinds_offset = offset;
+    offset = alignUp(offset + count * sizeof(NPCKind));
+    header.xs_offset = offset;
+    offset = alignUp(offset + count * sizeof(int32_t));
+    header.ys_offset = offset;
+    offset = alignUp(offset + count * sizeof(int32_t));
+    header.alive_offset = offset;
+    offset = alignUp(offset + world.aliveWordCount() * sizeof(uint64_t));
+    header.name_offsets_offset = offset;
+    offset = alignUp(offset + (count + 1) * sizeof(uint32_t));
+    header.name_chars_offset = offset;
+    header.file_size = offset + header.name_chars_size;
+    return header;
+}
+
+// RAII-   
+class MappedFile {
+private:
+    void* data = MAP_FAILED;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open world file: " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(WorldFileHeader))) {
+            ::close(fd);
+            throw std::runtime_error("World file is too small: " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        data = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Cannot map world file: " + path);
+        }
+    }
+
+    ~MappedFile() {
+        if (data != MAP_FAILED) ::munmap(data, length);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* bytes() const { return static_cast<const char*>(data); }
+    size_t size() const { return length; }
+};
+
+} // namespace
+
+constexpr char WorldFile::MAGIC[8];
+
+void WorldFile::save(const World& world, int map_width, int map_height, const std::string& path) {
+    static_assert(sizeof(NPCKind) == 1, "kind section is one byte per NPC");
+    static_assert(sizeof(int) == sizeof(int32_t), "coordinate sections are 32-bit");
+
+    WorldFileHeader header = makeHeader(world, map_width, map_height);
+    size_t count = world.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create world file: " + path);
+    }
+
+    //      
+    uint64_t written = 0;
+    auto writeSection = [&](uint64_t offset, const void* data, uint64_t size) {
+        static const char zeros[SECTION_ALIGN] = {};
+        file.write(zeros, static_cast<std::streamsize>(offset - written));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        written = offset + size;
+    };
+
+    std::vector<uint64_t> alive(world.aliveWordCount());
+    for (size_t i = 0; i < alive.size(); ++i) {
+        alive[i] = world.aliveWord(i);
+    }
+    //        
+    if (count % 64 != 0) {
+        alive.back() &= (uint64_t(1) << (count % 64)) - 1;
+    }
+
+    writeSection(0, &header, sizeof(header));
+    writeSection(header.kinds_offset, world.kindData(), count * sizeof(NPCKind));
+    writeSection(header.xs_offset, world.xData(), count * sizeof(int32_t));
+    writeSection(header.ys_offset, world.yData(), count * sizeof(int32_t));
+    writeSection(header.alive_offset, alive.data(), alive.size() * sizeof(uint64_t));
+    writeSection(header.name_offsets_offset, world.nameOffsetsData(), (count + 1) * sizeof(uint32_t));
+    writeSection(header.name_chars_offset, world.nameCharsData(), header.name_chars_size);
+
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Failed to write world file: " + path);
+    }
+}
+
+void WorldFile::load(const std::string& path, World& world, int& map_width, int& map_height) {
+    MappedFile mapped(path);
+    const char* base = mapped.bytes();
+
+    WorldFileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a world file: " + path);
+    }
+    if (header.byte_order != ENDIAN_MARK) {
+        throw std::runtime_error("World file was written with a different byte order: " + path);
+    }
+    if (header.version != VERSION) {
+        throw std::runtime_error("Unsupported world file version " + std::to_string(header.version));
+    }
+
+    //      ,    
+    //       .    
+    //  ,       
+    uint64_t count = header.count;
+    uint64_t alive_words = (count + 63) / 64;
+    uint64_t file_size = mapped.size();
+    uint64_t section_end = sizeof(WorldFileHeader);
+    auto section = [&](uint64_t offset, uint64_t size, uint64_t alignment) {
+        if (offset < section_end || offset > file_size || size > file_size - offset ||
+            offset % alignment != 0) {
+            return false;
+        }
+        section_end = offset + size;
+        return true;
+    };
+    bool valid = header.file_size == file_size &&
+                 count <= NPCHandle::MAX_SLOTS &&
+                 header.map_width > 0 && header.map_height > 0 &&
+                 section(header.kinds_offset, count * sizeof(NPCKind), alignof(NPCKind)) &&
+                 section(header.xs_offset, count * sizeof(int32_t), alignof(int32_t)) &&
+                 section(header.ys_offset, count * sizeof(int32_t), alignof(int32_t)) &&
+                 section(header.alive_offset, alive_words * sizeof(uint64_t), alignof(uint64_t)) &&
+                 section(header.name_offsets_offset, (count + 1) * sizeof(uint32_t), alignof(uint32_t)) &&
+                 section(header.name_chars_offset, header.name_chars_size, 1);
+    if (!valid) {
+        throw std::runtime_error("Corrupted world file: " + path);
+    }
+
+    //            ,
+    //      ,    
+    const auto* kinds = reinterpret_cast<const uint8_t*>(base + header.kinds_offset);
+    const auto* xs = reinterpret_cast<const int32_t*>(base + header.xs_offset);
+    const auto* ys = reinterpret_cast<const int32_t*>(base + header.ys_offset);
+    for (uint64_t i = 0; i < count; ++i) {
+        if (kinds[i] >= NPC_KIND_COUNT ||
+            xs[i] < 0 || xs[i] >= header.map_width || ys[i] < 0 || ys[i] >= header.map_height) {
+            throw std::runtime_error("Corrupted world file: " + path);
+        }
+    }
+
+    //         id >= count
+    const auto* alive = reinterpret_cast<const uint64_t*>(base + header.alive_offset);
+    if (count % 64 != 0 && (alive[alive_words - 1] >> (count % 64)) != 0) {
+        throw std::runtime_error("Corrupted world file: " + path);
+    }
+
+    const uint32_t* name_offsets = reinterpret_cast<const uint32_t*>(base + header.name_offsets_offset);
+    if (name_offsets[0] != 0 || name_offsets[count] != header.name_chars_size) {
+        throw std::runtime_error("Corrupted name table in world file: " + path);
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        if (name_offsets[i] > name_offsets[i + 1]) {
+            throw std::runtime_error("Corrupted world file: " + path);
+        }
+    }
+
+    world.assign(count,
+                 reinterpret_cast<const NPCKind*>(kinds),
+                 reinterpret_cast<const int*>(xs),
+                 reinterpret_cast<const int*>(ys),
+                 alive,
+                 name_offsets,
+                 base + header.name_chars_offset,
+                 header.name_chars_size);
+
+    map_width = header.map_width;
+    map_height = header.map_height;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef WORLD_FILE_H
+#define WORLD_FILE_H
+
+#include "world.h"
+#include <string>
+#include <cstdint>
+
+//   .      ,
+//   64 : , x, y,   ,
+//     .     World,
+//   -  mmap    
+struct WorldFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;        // 0x01020304     
+    uint64_t count;
+    int32_t map_width;
+    int32_t map_height;
+    uint64_t kinds_offset;
+    uint64_t xs_offset;
+    uint64_t ys_offset;
+    uint64_t alive_offset;
+    uint64_t name_offsets_offset;
+    uint64_t name_chars_offset;
+    uint64_t name_chars_size;
+    uint64_t file_size;
+};
+
+class WorldFile {
+public:
+    static constexpr char MAGIC[8] = {'B', 'F', '3', 'W', 'O', 'R', 'L', 'D'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t ENDIAN_MARK = 0x01020304u;
+    static constexpr uint64_t SECTION_ALIGN = 64;
+
+    //     ;  std::runtime_error  
+    static void save(const World& world, int map_width, int map_height, const std::string& path);
+
+    //         
+    static void load(const std::string& path, World& world, int& map_width, int& map_height);
+};
+
+#endif
\ No newline at end of file
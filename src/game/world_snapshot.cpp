@@ -0,0 +1,49 @@
+#include "world_snapshot.h"
+
+bool SnapshotBuffer::publish(const World& world, uint32_t tick) {
+    int front = published.load(std::memory_order_relaxed);
+    int back = front < 0 ? 0 : 1 - front;
+    
+    //        
+    if (readers[back].load(std::memory_order_seq_cst) != 0) {
+        skipped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    WorldFrame& frame = frames[back];
+    size_t count = world.size();
+    
+    frame.tick = tick;
+    frame.world = &world;
+    frame.xs.assign(world.xData(), world.xData() + count);
+    frame.ys.assign(world.yData(), world.yData() + count);
+    
+    frame.alive_bits.resize(world.aliveWordCount());
+    for (size_t i = 0; i < frame.alive_bits.size(); ++i) {
+        frame.alive_bits[i] = world.aliveWord(i);
+    }
+    
+    const PopulationStats& stats = world.stats();
+    for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        frame.alive_by_kind[kind] = stats.alive(static_cast<NPCKind>(kind));
+        frame.dead_by_kind[kind] = stats.dead(static_cast<NPCKind>(kind));
+    }
+    
+    published.store(back, std::memory_order_seq_cst);
+    return true;
+}
+
+SnapshotBuffer::ReadGuard SnapshotBuffer::read() const {
+    for (;;) {
+        int index = published.load(std::memory_order_seq_cst);
+        if (index < 0) return ReadGuard(this, -1);
+        
+        readers[index].fetch_add(1, std::memory_order_seq_cst);
+        
+        //    -       
+        if (published.load(std::memory_order_seq_cst) == index) {
+            return ReadGuard(this, index);
+        }
+        readers[index].fetch_sub(1, std::memory_order_release);
+    }
+}
\ No newline at end of file
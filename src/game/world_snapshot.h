@@ -0,0 +1,87 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include "world.h"
+#include <vector>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//      : ,  
+//    .       ,    World
+// (      ,   )
+struct WorldFrame {
+    uint32_t tick = 0;
+    const World* world = nullptr;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<uint64_t> alive_bits;
+    std::array<int, NPC_KIND_COUNT> alive_by_kind{};
+    std::array<int, NPC_KIND_COUNT> dead_by_kind{};
+
+    size_t size() const { return xs.size(); }
+
+    NPCKind kind(uint32_t id) const { return world->kind(id); }
+
+    bool isAlive(uint32_t id) const {
+        return (alive_bits[id >> 6] >> (id & 63)) & 1u;
+    }
+
+    int aliveCount() const {
+        int total = 0;
+        for (int count : alive_by_kind) total += count;
+        return total;
+    }
+};
+
+//   .        
+//   ;    ,  
+//  .  -    , 
+//  -     
+class SnapshotBuffer {
+private:
+    WorldFrame frames[2];
+    std::atomic<int> published{-1};
+    mutable std::atomic<int> readers[2] = {{0}, {0}};
+    std::atomic<uint64_t> skipped{0};
+
+public:
+    //    ,  
+    class ReadGuard {
+    private:
+        const SnapshotBuffer* owner = nullptr;
+        int index = -1;
+
+    public:
+        ReadGuard(const SnapshotBuffer* owner, int index) : owner(owner), index(index) {}
+        ReadGuard(ReadGuard&& other) noexcept : owner(other.owner), index(other.index) {
+            other.index = -1;
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        ~ReadGuard() {
+            if (index >= 0) owner->readers[index].fetch_sub(1, std::memory_order_release);
+        }
+
+        explicit operator bool() const { return index >= 0; }
+        const WorldFrame& operator*() const { return owner->frames[index]; }
+        const WorldFrame* operator->() const { return &owner->frames[index]; }
+    };
+
+    SnapshotBuffer() = default;
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+    //         ;
+    //   ,   NPC. false -  
+    bool publish(const World& world, uint32_t tick);
+
+    //     ( guard,     )
+    ReadGuard read() const;
+
+    uint64_t getSkipped() const { return skipped.load(std::memory_order_relaxed); }
+};
+
+#endif
\ No newline at end of file
@@ -1,27 +1,192 @@
 #include "game/game_manager.h"
+#include "shard/shard_coordinator.h"
+#include "utils/random.h"
+#include "utils/trace.h"
 #include <iostream>
+#include <cerrno>
 #include <csignal>
+#include <cstring>
+#include <string>
+#include <random>
+#include <stdexcept>
 
 //   GameManager   
 GameManager* global_game_manager = nullptr;
+ShardCoordinator* global_coordinator = nullptr;
 
-// 
-void signalHandler(int signal) {
+//  
+static GameConfig parseArguments(int argc, char* argv[], uint64_t& seed, 
+                                 std::string& trace_path) {
+    GameConfig config;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+        
+        if (arg == "--headless") config.headless = true;
+        else if (arg == "--width") config.map_width = std::stoi(value());
+        else if (arg == "--height") config.map_height = std::stoi(value());
+        else if (arg == "--npcs") config.total_npcs = std::stoi(value());
+        else if (arg == "--ticks") config.ticks = std::stoi(value());
+        else if (arg == "--duration") config.game_duration = std::stoi(value());
+        else if (arg == "--display-width") config.display_width = std::stoi(value());
+        else if (arg == "--display-height") config.display_height = std::stoi(value());
+        else if (arg == "--move-threads") config.movement_threads = std::stoi(value());
+        else if (arg == "--battle-threads") config.battle_threads = std::stoi(value());
+        else if (arg == "--scheduler") {
+            std::string scheduler = value();
+            if (scheduler == "threads") config.scheduler = GameConfig::Scheduler::Threads;
+            else if (scheduler == "jobs") config.scheduler = GameConfig::Scheduler::Jobs;
+            else if (scheduler == "regions") config.scheduler = GameConfig::Scheduler::Regions;
+            else throw std::invalid_argument("Unknown scheduler: " + scheduler);
+        }
+        else if (arg == "--job-workers") config.job_workers = std::stoi(value());
+        else if (arg == "--regions") config.regions = std::stoi(value());
+        else if (arg == "--shards") config.shards = std::stoi(value());
+        else if (arg == "--transport") {
+            std::string transport = value();
+            if (!Transport::kindFromName(transport, config.shard_transport)) {
+                throw std::invalid_argument("Unknown transport: " + transport);
+            }
+        }
+        else if (arg == "--seed") seed = std::stoull(value());
+        else if (arg == "--log-flush-ms") config.log_flush_ms = std::stoi(value());
+        else if (arg == "--log-capacity") config.log_capacity = std::stoul(value());
+        else if (arg == "--no-pool") config.pooled_npcs = false;
+        else if (arg == "--metrics") config.metrics_path = value();
+        else if (arg == "--trace") trace_path = value();
+        else if (arg == "--metrics-interval-ms") config.metrics_interval_ms = std::stoi(value());
+        else if (arg == "--load") config.load_path = value();
+        else if (arg == "--save") config.save_path = value();
+        else if (arg == "--queue") {
+            std::string backend = value();
+            if (backend == "mutex") config.queue_backend = BattleQueue::Backend::Mutex;
+            else if (backend == "lockfree") config.queue_backend = BattleQueue::Backend::LockFree;
+            else throw std::invalid_argument("Unknown queue backend: " + backend);
+        }
+        else if (arg == "--queue-capacity") config.queue_capacity = std::stoul(value());
+        else if (arg == "--queue-overflow") {
+            std::string policy = value();
+            if (policy == "oldest") config.queue_overflow = BattleQueue::Overflow::DropOldest;
+            else if (policy == "newest") config.queue_overflow = BattleQueue::Overflow::DropNewest;
+            else if (policy == "block") config.queue_overflow = BattleQueue::Overflow::Block;
+            else throw std::invalid_argument("Unknown queue overflow policy: " + policy);
+        }
+        else throw std::invalid_argument("Unknown option: " + arg);
+    }
+    
+    if (config.map_width <= 0 || config.map_height <= 0 || config.total_npcs < 0) {
+        throw std::invalid_argument("World size and NPC count must be positive");
+    }
+    if (config.shards <= 0) {
+        throw std::invalid_argument("Shard count must be positive");
+    }
+    if (config.display_width <= 0 || config.display_height <= 0) {
+        throw std::invalid_argument("Display size must be positive");
+    }
+    
+    return config;
+}
+
+static void printUsage() {
+    std::cout << "Usage: balagur_fate_3 [options]\n"
+              << "  --headless            run ticks back-to-back without display\n"
+              << "  --ticks N             number of ticks in headless mode\n"
+              << "  --duration N          duration in seconds in real-time mode\n"
+              << "  --width N --height N  map size\n"
+              << "  --display-width N --display-height N  on-screen map size\n"
+              << "  --npcs N              number of NPCs\n"
+              << "  --move-threads N      movement threads (0 = all cores)\n"
+              << "  --battle-threads N    battle threads (0 = all cores)\n"
+              << "  --scheduler threads|jobs|regions  fixed worker threads, a work-stealing\n"
+              << "                        job graph or one owner thread per map strip\n"
+              << "  --job-workers N       job pool size for --scheduler jobs (0 = all cores)\n"
+              << "  --regions N           map strips for --scheduler regions (0 = all cores)\n"
+              << "  --shards N            run N processes, one map tile each (1 = single process)\n"
+              << "  --transport shm|unix  link between shard processes: shared-memory rings\n"
+              << "                        or Unix domain sockets\n"
+              << "  --queue mutex|lockfree  battle queue backend\n"
+              << "  --queue-capacity N    battle queue capacity\n"
+              << "  --queue-overflow oldest|newest|block  policy when the queue is full\n"
+              << "  --seed N              seed for a reproducible run\n"
+              << "  --log-flush-ms N      kill log flush interval\n"
+              << "  --log-capacity N      kill log records buffered between flushes\n"
+              << "  --no-pool             build NPC facades one by one instead of from arenas\n"
+              << "  --metrics FILE        periodically write phase metrics in Prometheus format\n"
+              << "  --metrics-interval-ms N  metrics file update interval\n"
+              << "  --trace FILE          record a Chrome trace_event JSON (open in Perfetto)\n"
+              << "  --load FILE           start from a saved world (overrides map size and NPCs)\n"
+              << "  --save FILE           save the world after the run\n";
+}
+
+// :     ( 
+// write  eventfd),    ,  
+void signalHandler(int /*signal*/) {
+    int saved_errno = errno;
+    if (global_coordinator) {
+        global_coordinator->stop();
+    }
     if (global_game_manager) {
-        std::cout << "\n\nReceived interrupt signal. Stopping game..." << std::endl;
-        global_game_manager->stop();
+        global_game_manager->requestStop();
     }
+    errno = saved_errno;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     //  
     std::signal(SIGINT, signalHandler);
     
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage();
+            return 0;
+        }
+    }
+    
     try {
-        GameManager game;
-        global_game_manager = &game;
+        //    : --seed N  
+        uint64_t seed = std::random_device{}();
+        std::string trace_path;
+        GameConfig config = parseArguments(argc, argv, seed, trace_path);
+        Random::setSeed(seed);
+        
+        if (!trace_path.empty()) {
+            Trace::enable();
+            Trace::setThreadName("main");
+        }
+        
+        if (config.shards > 1) {
+            //  -  ,    
+            ShardCoordinator coordinator(config, static_cast<size_t>(config.shards));
+            global_coordinator = &coordinator;
+            
+            coordinator.run();
+            
+            global_coordinator = nullptr;
+        } else {
+            GameManager game(config);
+            global_game_manager = &game;
+            
+            game.run();
+            
+            global_game_manager = nullptr;
+        }
         
-        game.run();
+        // ,     (  )  
+        if (!trace_path.empty()) {
+            Trace::disable();
+            if (Trace::dump(trace_path)) {
+                std::cout << "Trace saved to '" << trace_path << "'" << std::endl;
+            } else {
+                std::cerr << "Cannot write trace to '" << trace_path << "'" << std::endl;
+            }
+        }
         
         std::cout << "\nSimulation completed successfully!" << std::endl;
         
@@ -31,5 +196,6 @@ int main() {
     }
     
     global_game_manager = nullptr;
+    global_coordinator = nullptr;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "kind_npc.h"
+#include "../utils/random.h"
+#include "../utils/dice.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+template <NPCKind K>
+KindNPC<K>::KindNPC(World& world, uint32_t id, 
+                    std::vector<std::shared_ptr<Observer>>* shared_observers) 
+    : world(world), id(id), shared_observers(shared_observers) {}
+
+template <NPCKind K>
+void KindNPC<K>::print() const {
+    std::cout << KindTraits<K>::name << " " << world.name(id) 
+              << " at (" << world.x(id) << ", " << world.y(id) << ")" 
+              << (world.isAlive(id) ? " [ALIVE]" : " [DEAD]") << std::endl;
+}
+
+template <NPCKind K>
+std::string KindNPC<K>::getName() const { 
+    return std::string(world.name(id)); 
+}
+
+template <NPCKind K>
+std::pair<int, int> KindNPC<K>::getPosition() const { 
+    return {world.x(id), world.y(id)}; 
+}
+
+template <NPCKind K>
+bool KindNPC<K>::isAlive() const { 
+    return world.isAlive(id); 
+}
+
+template <NPCKind K>
+void KindNPC<K>::setAlive(bool is_alive) { 
+    world.setAlive(id, is_alive); 
+}
+
+template <NPCKind K>
+void KindNPC<K>::moveRandomly(int map_width, int map_height) {
+    if (!isAlive()) return;
+    
+    constexpr int distance = KindTraits<K>::move_distance;
+    int dx = Random::getInt(-distance, distance);
+    int dy = Random::getInt(-distance, distance);
+    
+    int x = std::max(0, std::min(map_width - 1, world.x(id) + dx));
+    int y = std::max(0, std::min(map_height - 1, world.y(id) + dy));
+    world.setPosition(id, x, y);
+}
+
+template <NPCKind K>
+bool KindNPC<K>::canKill(const std::shared_ptr<NPC>& other) const {
+    return kindCanKill(K, other->getKind());
+}
+
+template <NPCKind K>
+int KindNPC<K>::rollAttackDice() {
+    return Dice::roll();
+}
+
+template <NPCKind K>
+int KindNPC<K>::rollDefenseDice() {
+    return Dice::roll();
+}
+
+template <NPCKind K>
+void KindNPC<K>::addObserver(const std::shared_ptr<Observer>& observer) {
+    observers().push_back(observer);
+}
+
+template <NPCKind K>
+void KindNPC<K>::notifyKill(const std::shared_ptr<NPC>& victim) {
+    NPCHandle killer_handle = world.handle(id);
+    NPCHandle victim_handle = victim->getHandle();
+    for (const auto& observer : observers()) {
+        observer->onKill(world, killer_handle, victim_handle);
+    }
+}
+
+template <NPCKind K>
+void KindNPC<K>::save(std::ostream& file) const {
+    file << KindTraits<K>::name << " " << world.name(id) << " " << world.x(id) << " " 
+         << world.y(id) << " " << (world.isAlive(id) ? 1 : 0) << "\n";
+}
+
+template class KindNPC<NPCKind::Bear>;
+template class KindNPC<NPCKind::Werewolf>;
+template class KindNPC<NPCKind::Bandit>;
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef KIND_NPC_H
+#define KIND_NPC_H
+
+#include "npc.h"
+#include "npc_kind.h"
+#include "../observer/observer.h"
+#include "../game/world.h"
+#include <memory>
+#include <vector>
+
+//       NPC  K:   
+//   KindTraits<K>   ,     World
+template <NPCKind K>
+class KindNPC : public NPC {
+private:
+    World& world;
+    uint32_t id;
+    
+    //       ,     ;
+    //       
+    std::vector<std::shared_ptr<Observer>> own_observers;
+    std::vector<std::shared_ptr<Observer>>* shared_observers;
+    
+    std::vector<std::shared_ptr<Observer>>& observers() {
+        return shared_observers ? *shared_observers : own_observers;
+    }
+    
+public:
+    KindNPC(World& world, uint32_t id, 
+            std::vector<std::shared_ptr<Observer>>* shared_observers = nullptr);
+    
+    void print() const override;
+    std::string getName() const override;
+    std::string getType() const override { return KindTraits<K>::name; }
+    NPCKind getKind() const final { return K; }
+    std::pair<int, int> getPosition() const override;
+    uint32_t getId() const override { return id; }
+    NPCHandle getHandle() const override { return world.handle(id); }
+    
+    bool isAlive() const override;
+    void setAlive(bool alive) override;
+    void moveRandomly(int map_width, int map_height) override;
+    bool canKill(const std::shared_ptr<NPC>& other) const override;
+    
+    int rollAttackDice() override;
+    int rollDefenseDice() override;
+    
+    int getMoveDistance() const override { return KindTraits<K>::move_distance; }
+    int getKillDistance() const override { return KindTraits<K>::kill_distance; }
+    
+    void addObserver(const std::shared_ptr<Observer>& observer) override;
+    void notifyKill(const std::shared_ptr<NPC>& victim) override;
+    
+    void save(std::ostream& file) const override;
+};
+
+//   kind_npc.cpp
+extern template class KindNPC<NPCKind::Bear>;
+extern template class KindNPC<NPCKind::Werewolf>;
+extern template class KindNPC<NPCKind::Bandit>;
+
+#endif
\ No newline at end of file
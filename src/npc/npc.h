@@ -5,9 +5,11 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
-#include <random>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include "npc_kind.h"
+#include "../game/npc_handle.h"
 
 class Observer;
 
@@ -18,7 +20,10 @@ public:
     virtual void print() const = 0;
     virtual std::string getName() const = 0;
     virtual std::string getType() const = 0;
+    virtual NPCKind getKind() const = 0;
     virtual std::pair<int, int> getPosition() const = 0;
+    virtual uint32_t getId() const = 0;
+    virtual NPCHandle getHandle() const = 0;
     
     virtual bool isAlive() const = 0;
     virtual void setAlive(bool alive) = 0;
@@ -37,11 +42,6 @@ public:
     virtual void save(std::ostream& file) const = 0;
     
     virtual double calculateDistance(const std::shared_ptr<NPC>& other) const;
-    
-protected:
-    static std::random_device rd;
-    static std::mt19937 gen;
-    static std::uniform_int_distribution<> dice_dist;
 };
 
 #endif
\ No newline at end of file
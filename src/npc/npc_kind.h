@@ -0,0 +1,120 @@
+#ifndef NPC_KIND_H
+#define NPC_KIND_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+//  NPC      
+enum class NPCKind : uint8_t {
+    Bear = 0,
+    Werewolf = 1,
+    Bandit = 2
+};
+
+constexpr int NPC_KIND_COUNT = 3;
+
+//       
+template <NPCKind K>
+struct KindTraits;
+
+template <>
+struct KindTraits<NPCKind::Bear> {
+    static constexpr const char* name = "Bear";
+    static constexpr char symbol = 'B';
+    static constexpr int move_distance = 5;
+    static constexpr int kill_distance = 10;
+    static constexpr NPCKind prey = NPCKind::Werewolf;
+};
+
+template <>
+struct KindTraits<NPCKind::Werewolf> {
+    static constexpr const char* name = "Werewolf";
+    static constexpr char symbol = 'W';
+    static constexpr int move_distance = 40;
+    static constexpr int kill_distance = 5;
+    static constexpr NPCKind prey = NPCKind::Bandit;
+};
+
+template <>
+struct KindTraits<NPCKind::Bandit> {
+    static constexpr const char* name = "Bandit";
+    static constexpr char symbol = 'R';
+    static constexpr int move_distance = 10;
+    static constexpr int kill_distance = 10;
+    static constexpr NPCKind prey = NPCKind::Bear;
+};
+
+//   ,   KindTraits;  -  NPCKind
+namespace kind_table {
+
+template <template <NPCKind> class Field, typename T>
+constexpr std::array<T, NPC_KIND_COUNT> build() {
+    return {Field<NPCKind::Bear>::value, Field<NPCKind::Werewolf>::value, Field<NPCKind::Bandit>::value};
+}
+
+template <NPCKind K> struct Name { static constexpr const char* value = KindTraits<K>::name; };
+template <NPCKind K> struct Symbol { static constexpr char value = KindTraits<K>::symbol; };
+template <NPCKind K> struct MoveDistance { static constexpr int value = KindTraits<K>::move_distance; };
+template <NPCKind K> struct KillDistance { static constexpr int value = KindTraits<K>::kill_distance; };
+template <NPCKind K> struct Prey { static constexpr NPCKind value = KindTraits<K>::prey; };
+
+constexpr auto NAME = build<Name, const char*>();
+constexpr auto SYMBOL = build<Symbol, char>();
+constexpr auto MOVE_DISTANCE = build<MoveDistance, int>();
+constexpr auto KILL_DISTANCE = build<KillDistance, int>();
+constexpr auto PREY = build<Prey, NPCKind>();
+
+constexpr int maxOf(const std::array<int, NPC_KIND_COUNT>& values) {
+    int result = values[0];
+    for (int value : values) {
+        if (value > result) result = value;
+    }
+    return result;
+}
+
+} // namespace kind_table
+
+//    -    
+constexpr int MAX_KILL_DISTANCE = kind_table::maxOf(kind_table::KILL_DISTANCE);
+constexpr int MAX_MOVE_DISTANCE = kind_table::maxOf(kind_table::MOVE_DISTANCE);
+
+constexpr const char* kindName(NPCKind kind) {
+    return kind_table::NAME[static_cast<int>(kind)];
+}
+
+//   
+constexpr char kindSymbol(NPCKind kind) {
+    return kind_table::SYMBOL[static_cast<int>(kind)];
+}
+
+constexpr int kindMoveDistance(NPCKind kind) {
+    return kind_table::MOVE_DISTANCE[static_cast<int>(kind)];
+}
+
+constexpr int kindKillDistance(NPCKind kind) {
+    return kind_table::KILL_DISTANCE[static_cast<int>(kind)];
+}
+
+//   ,  - ,  - 
+constexpr bool kindCanKill(NPCKind attacker, NPCKind victim) {
+    return kind_table::PREY[static_cast<int>(attacker)] == victim;
+}
+
+static_assert(kindCanKill(NPCKind::Werewolf, NPCKind::Bandit), "Werewolf kills Bandit");
+static_assert(kindCanKill(NPCKind::Bandit, NPCKind::Bear), "Bandit kills Bear");
+static_assert(kindCanKill(NPCKind::Bear, NPCKind::Werewolf), "Bear kills Werewolf");
+static_assert(!kindCanKill(NPCKind::Bear, NPCKind::Bandit), "Bear does not kill Bandit");
+
+//  false,    
+inline bool kindFromName(const std::string& name, NPCKind& kind) {
+    for (int i = 0; i < NPC_KIND_COUNT; ++i) {
+        if (name == kind_table::NAME[i]) {
+            kind = static_cast<NPCKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
\ No newline at end of file
@@ -1,14 +1,51 @@
 #include "console_observer.h"
+#include "../game/world.h"
 #include <iostream>
 #include <mutex>
 
 //    std::cout
 static std::mutex cout_mutex;
 
-void ConsoleObserver::onKill(const std::shared_ptr<NPC>& killer, 
-                            const std::shared_ptr<NPC>& victim) {
+void ConsoleObserver::appendKill(const World& world, NPCHandle killer, NPCHandle victim) {
+    uint32_t killer_id, victim_id;
+    if (!world.resolve(killer, killer_id) || !world.resolve(victim, victim_id)) {
+        return; //  
+    }
+    
+    buffer += "[KILL] ";
+    buffer += kindName(world.kind(killer_id));
+    buffer += ' ';
+    buffer += world.name(killer_id);
+    buffer += " killed ";
+    buffer += kindName(world.kind(victim_id));
+    buffer += ' ';
+    buffer += world.name(victim_id);
+    buffer += '\n';
+}
+
+void ConsoleObserver::onKill(const World& world, NPCHandle killer, NPCHandle victim) {
+    //      ,    
+    uint32_t killer_id, victim_id;
+    if (!world.resolve(killer, killer_id) || !world.resolve(victim, victim_id)) {
+        return; //  
+    }
+    
     std::lock_guard<std::mutex> lock(cout_mutex);
-    std::cout << "[KILL] " << killer->getType() << " " << killer->getName()
-              << " killed " << victim->getType() << " " << victim->getName() 
+    std::cout << "[KILL] " << kindName(world.kind(killer_id)) << " " << world.name(killer_id)
+              << " killed " << kindName(world.kind(victim_id)) << " " << world.name(victim_id) 
               << std::endl;
+}
+
+void ConsoleObserver::onKills(const World& world, Span<KillEvent> events) {
+    if (events.empty()) return;
+    
+    //    :   ,
+    //        
+    buffer.clear();
+    for (const auto& event : events) {
+        appendKill(world, event.killer, event.victim);
+    }
+    
+    std::lock_guard<std::mutex> lock(cout_mutex);
+    std::cout << buffer << std::flush;
 }
\ No newline at end of file
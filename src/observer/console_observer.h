@@ -2,11 +2,18 @@
 #define CONSOLE_OBSERVER_H
 
 #include "observer.h"
+#include <string>
 
 class ConsoleObserver : public Observer {
+private:
+    //        
+    std::string buffer;
+
+    void appendKill(const World& world, NPCHandle killer, NPCHandle victim);
+
 public:
-    void onKill(const std::shared_ptr<NPC>& killer, 
-                const std::shared_ptr<NPC>& victim) override;
+    void onKill(const World& world, NPCHandle killer, NPCHandle victim) override;
+    void onKills(const World& world, Span<KillEvent> events) override;
 };
 
 #endif
\ No newline at end of file
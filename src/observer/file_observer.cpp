@@ -1,24 +1,136 @@
 #include "file_observer.h"
-#include <mutex>
+#include "../game/world.h"
+#include "../utils/trace.h"
+#include <algorithm>
 
-static std::mutex file_mutex;
-
-FileObserver::FileObserver() {
-    logFile.open("log.txt", std::ios::app);
+FileObserver::FileObserver(const std::string& path, 
+                           std::chrono::milliseconds flush_interval, 
+                           size_t capacity,
+                           size_t wake_threshold)
+    : flush_interval(flush_interval), singles(std::max<size_t>(1, capacity)), capacity(std::max<size_t>(1, capacity)), 
+      wake_threshold(std::min(wake_threshold, this->capacity)) {
+    //     ,    
+    pending.reserve(this->capacity);
+    draining.reserve(this->capacity);
+    logFile.open(path, std::ios::app);
+    writer = std::thread([this]() { writerLoop(); });
 }
 
 FileObserver::~FileObserver() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        running = false;
+    }
+    wake.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    
     if (logFile.is_open()) {
         logFile.close();
     }
 }
 
-void FileObserver::onKill(const std::shared_ptr<NPC>& killer, 
-                         const std::shared_ptr<NPC>& victim) {
-    std::lock_guard<std::mutex> lock(file_mutex);
-    if (logFile.is_open()) {
-        logFile << "[KILL] " << killer->getType() << " " << killer->getName()
-                << " killed " << victim->getType() << " " << victim->getName() 
-                << std::endl;
+void FileObserver::onKill(const World& world, NPCHandle killer, NPCHandle victim) {
+    //     :   -  
+    if (!singles.tryPush(KillRecord{&world, killer, victim})) {
+        dropped++;
+        return;
+    }
+    wakeIfFull(singles.sizeApprox());
+}
+
+void FileObserver::onKills(const World& world, Span<KillEvent> events) {
+    if (events.empty()) return;
+    
+    //      
+    size_t size;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        size_t accepted = std::min(events.size(), capacity - pending.size());
+        for (size_t i = 0; i < accepted; ++i) {
+            pending.push_back(KillRecord{&world, events[i].killer, events[i].victim});
+        }
+        dropped += events.size() - accepted;
+        size = pending.size();
+    }
+    wakeIfFull(size);
+}
+
+void FileObserver::wakeIfFull(size_t size) {
+    //      ,    
+    if (size < wake_threshold) return;
+    
+    std::lock_guard<std::mutex> lock(wake_mutex);
+    if (!flush_requested) {
+        flush_requested = true;
+        wake.notify_one();
+    }
+}
+
+void FileObserver::flush() {
+    std::string buffer;
+    drain(buffer);
+}
+
+void FileObserver::drain(std::string& buffer) {
+    TRACE_SCOPE("drain kill log", "io");
+    std::lock_guard<std::mutex> lock(drain_mutex);
+    buffer.clear();
+    
+    //   ,      
+    draining.clear();
+    {
+        std::lock_guard<std::mutex> pending_lock(pending_mutex);
+        pending.swap(draining);
+    }
+    
+    for (const auto& record : draining) {
+        format(record, buffer);
+    }
+    KillRecord record;
+    while (singles.tryPop(record)) {
+        format(record, buffer);
+    }
+    
+    //     
+    if (!buffer.empty() && logFile.is_open()) {
+        logFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        logFile.flush();
+    }
+}
+
+void FileObserver::format(const KillRecord& record, std::string& buffer) {
+    uint32_t killer_id, victim_id;
+    if (!record.world->resolve(record.killer, killer_id) || 
+        !record.world->resolve(record.victim, victim_id)) {
+        return; //     
+    }
+    
+    buffer += "[KILL] ";
+    buffer += kindName(record.world->kind(killer_id));
+    buffer += ' ';
+    buffer += record.world->name(killer_id);
+    buffer += " killed ";
+    buffer += kindName(record.world->kind(victim_id));
+    buffer += ' ';
+    buffer += record.world->name(victim_id);
+    buffer += '\n';
+}
+
+void FileObserver::writerLoop() {
+    Trace::setThreadName("log writer");
+    std::string buffer;
+    
+    while (running) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait_for(lock, flush_interval, [this]() { return !running || flush_requested; });
+            flush_requested = false;
+        }
+        drain(buffer);
     }
+    
+    //  ,    
+    drain(buffer);
 }
\ No newline at end of file
@@ -2,18 +2,78 @@
 #define FILE_OBSERVER_H
 
 #include "observer.h"
+#include "../game/mpmc_ring.h"
 #include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
+//       ,   
+//    .   (onKills)   
+//    ,     .
+//   (onKill)   lock-free   .
+//   :   ,   
+//  ,   
 class FileObserver : public Observer {
 private:
+    struct KillRecord {
+        const World* world = nullptr;
+        NPCHandle killer;
+        NPCHandle victim;
+    };
+    
     std::ofstream logFile;
+    std::chrono::milliseconds flush_interval;
+    
+    //    
+    MPMCRing<KillRecord> singles;
+    
+    //    ,    
+    std::mutex pending_mutex;
+    std::vector<KillRecord> pending;
+    std::vector<KillRecord> draining;
+    size_t capacity;
+    size_t wake_threshold;
+    std::atomic<size_t> dropped{0};
+    
+    std::thread writer;
+    std::atomic<bool> running{true};
+    std::mutex drain_mutex;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    
+    //    ;     wake_mutex
+    //   ,    
+    bool flush_requested = false;
+    
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    static constexpr size_t DEFAULT_WAKE_THRESHOLD = DEFAULT_CAPACITY / 2;
+    
+    void writerLoop();
+    void drain(std::string& buffer);
+    static void format(const KillRecord& record, std::string& buffer);
+    void wakeIfFull(size_t size);
 
 public:
-    FileObserver();
+    explicit FileObserver(const std::string& path = "log.txt",
+                          std::chrono::milliseconds flush_interval = std::chrono::milliseconds(50),
+                          size_t capacity = DEFAULT_CAPACITY,
+                          size_t wake_threshold = DEFAULT_WAKE_THRESHOLD);
     ~FileObserver();
     
-    void onKill(const std::shared_ptr<NPC>& killer, 
-                const std::shared_ptr<NPC>& victim) override;
+    void onKill(const World& world, NPCHandle killer, NPCHandle victim) override;
+    void onKills(const World& world, Span<KillEvent> events) override;
+    
+    //    ;    ,
+    //     flush   
+    void flush() override;
+    
+    // ,      
+    size_t getDropped() const { return dropped.load(); }
 };
 
 #endif
\ No newline at end of file
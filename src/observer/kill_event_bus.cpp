@@ -0,0 +1,43 @@
+#include "kill_event_bus.h"
+#include "../utils/trace.h"
+#include <atomic>
+
+size_t KillEventBus::shardIndex() {
+    //        
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t index = next_shard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return index;
+}
+
+void KillEventBus::publish(const KillEvent& event) {
+    Shard& shard = shards[shardIndex()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.events.push_back(event);
+}
+
+size_t KillEventBus::deliver(const World& world, 
+                             const std::vector<std::shared_ptr<Observer>>& observers) {
+    std::lock_guard<std::mutex> deliver_lock(deliver_mutex);
+    batch.clear();
+    
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        batch.insert(batch.end(), shard.events.begin(), shard.events.end());
+        shard.events.clear();
+    }
+    
+    if (batch.empty()) return 0;
+    
+    TRACE_SCOPE("deliver kills", "observer");
+    for (const auto& observer : observers) {
+        observer->onKills(world, Span<KillEvent>(batch));
+    }
+    return batch.size();
+}
+
+void KillEventBus::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.events.clear();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef KILL_EVENT_BUS_H
+#define KILL_EVENT_BUS_H
+
+#include "observer.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//    :      
+// ,         
+//       onKills
+class KillEventBus {
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    
+    //      ,     
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<KillEvent> events;
+    };
+    
+    std::array<Shard, SHARD_COUNT> shards;
+    
+    //   ;   ,    
+    std::mutex deliver_mutex;
+    std::vector<KillEvent> batch;
+    
+    static size_t shardIndex();
+
+public:
+    //  ;    
+    void publish(const KillEvent& event);
+    
+    //     ;   
+    size_t deliver(const World& world, const std::vector<std::shared_ptr<Observer>>& observers);
+    
+    //    
+    void clear();
+};
+
+#endif
\ No newline at end of file
@@ -1,14 +1,36 @@
 #ifndef OBSERVER_H
 #define OBSERVER_H
 
-#include "../npc/npc.h"
-#include <memory>
+#include "../game/npc_handle.h"
+#include "../utils/span.h"
+#include <cstdint>
+
+class World;
+
+//    tick
+struct KillEvent {
+    NPCHandle killer;
+    NPCHandle victim;
+    uint32_t tick = 0;
+};
 
 class Observer {
 public:
     virtual ~Observer() = default;
-    virtual void onKill(const std::shared_ptr<NPC>& killer, 
-                       const std::shared_ptr<NPC>& victim) = 0;
+    
+    //    world;  NPC     World::resolve
+    virtual void onKill(const World& world, NPCHandle killer, NPCHandle victim) = 0;
+    
+    //     ;     
+    //  onKill,       
+    virtual void onKills(const World& world, Span<KillEvent> events) {
+        for (const auto& event : events) {
+            onKill(world, event.killer, event.victim);
+        }
+    }
+    
+    //    (  )
+    virtual void flush() {}
 };
 
 #endif
\ No newline at end of file
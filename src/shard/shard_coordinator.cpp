@@ -0,0 +1,317 @@
+#include "shard_coordinator.h"
+#include "shard_node.h"
+#include "../game/game_manager.h"
+#include "../utils/random.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+//     : log.txt -> log.shard2.txt
+std::string shardLogPath(const std::string& path, size_t index) {
+    std::string suffix = ".shard" + std::to_string(index);
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return path + suffix;
+    }
+    return path.substr(0, dot) + suffix + path.substr(dot);
+}
+
+//  -;   
+int runShard(const GameConfig& config, size_t index, size_t count, ShardNode::Links links) {
+    // Ctrl+C    ,    
+    std::signal(SIGINT, SIG_IGN);
+    
+    //     ,    
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    }
+    
+    try {
+        GameConfig shard_config = config;
+        shard_config.headless = true;
+        shard_config.log_path = shardLogPath(config.log_path, index);
+        
+        GameManager game(shard_config);
+        ShardNode node(game, index, count, std::move(links));
+        node.run();
+    } catch (const std::exception& e) {
+        std::cerr << "Shard " << index << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+ShardCoordinator::ShardCoordinator(const GameConfig& config, size_t shards)
+    : config(config) {
+    //     NPC  
+    count = std::max<size_t>(1, std::min(shards, ShardNode::maxShards(config.map_width)));
+    int width = ShardNode::tileWidth(config.map_width, count);
+    count = static_cast<size_t>((config.map_width + width - 1) / width);
+}
+
+ShardCoordinator::~ShardCoordinator() {
+    terminateShards();
+}
+
+void ShardCoordinator::run() {
+    std::cout << "=== Balagur Fate 3 - Sharded Simulation ===" << std::endl;
+    std::cout << "Map size: " << config.map_width << "x" << config.map_height << std::endl;
+    std::cout << "Seed: " << Random::getSeed() << std::endl;
+    std::cout << "Shards: " << count << " tiles of " << ShardNode::tileWidth(config.map_width, count)
+              << " columns, transport " << Transport::kindName(config.shard_transport) << std::endl;
+    
+    launch();
+    
+    started_at = std::chrono::steady_clock::now();
+    auto status_at = started_at;
+    uint32_t alive = 0;
+    
+    for (;;) {
+        auto tick_started = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(tick_started - started_at).count();
+        bool finished = stop_signal.isRaised() || 
+                        (config.headless ? tick >= static_cast<uint32_t>(config.ticks) 
+                                         : elapsed >= config.game_duration);
+        if (finished) break;
+        
+        tick++;
+        broadcast(ShardCommand{tick, 0});
+        
+        alive = 0;
+        for (auto& shard : shards) {
+            auto report = shard_protocol::decode<ShardTickReport>(shard.report);
+            if (report.tick != tick) {
+                throw std::runtime_error("Shard reported a wrong tick");
+            }
+            total_battles += report.battles;
+            total_kills += report.kills;
+            alive += report.alive;
+            shard.busy_ns += report.busy_ns;
+        }
+        auto tick_time = std::chrono::steady_clock::now() - tick_started;
+        tick_latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(tick_time).count()));
+        
+        if (!config.headless) {
+            //       
+            auto now = std::chrono::steady_clock::now();
+            if (now - status_at >= std::chrono::seconds(1)) {
+                status_at = now;
+                printStatus(std::chrono::duration<double>(now - started_at).count(), alive);
+            }
+            //   ,     ( 10   )
+            stop_signal.waitUntil(tick_started + std::chrono::milliseconds(100));
+        }
+    }
+    stopped_at = std::chrono::steady_clock::now();
+    
+    if (stop_signal.isRaised()) {
+        std::cout << "\n\nReceived interrupt signal. Stopping shards..." << std::endl;
+    }
+    broadcast(ShardCommand{tick, 1});
+    for (auto& shard : shards) {
+        shard.final_report = shard_protocol::decode<ShardFinalReport>(shard.report);
+    }
+    waitShards();
+    
+    printFinalReport();
+}
+
+void ShardCoordinator::launch() {
+    //     fork,     
+    std::vector<std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>>> control;
+    std::vector<std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>>> neighbours;
+    for (size_t i = 0; i < count; ++i) {
+        control.push_back(Transport::createPair(config.shard_transport));
+    }
+    for (size_t i = 0; i + 1 < count; ++i) {
+        neighbours.push_back(Transport::createPair(config.shard_transport));
+    }
+    
+    //         
+    std::cout.flush();
+    std::fflush(stdout);
+    
+    pid_t coordinator_pid = getpid();
+    shards.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot start shard process");
+        }
+        
+        if (pid == 0) {
+            //     -   SIGTERM,  
+            //  ;      prctl,    getppid
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            if (getppid() != coordinator_pid) _exit(1);
+            
+            ShardNode::Links links;
+            links.coordinator_pid = coordinator_pid;
+            links.coordinator = std::move(control[i].second);
+            if (i > 0) links.left = std::move(neighbours[i - 1].second);
+            if (i + 1 < count) links.right = std::move(neighbours[i].first);
+            //   ,      
+            control.clear();
+            neighbours.clear();
+            
+            // _exit:      
+            _exit(runShard(config, i, count, std::move(links)));
+        }
+        shards[i].pid = pid;
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        shards[i].link = std::move(control[i].first);
+    }
+}
+
+void ShardCoordinator::broadcast(const ShardCommand& command) {
+    MessageExchange exchange;
+    for (auto& shard : shards) {
+        shard_protocol::encode(command, shard.command);
+        exchange.send(*shard.link, shard.command);
+        exchange.receive(*shard.link, shard.report);
+    }
+    exchange.run([this]() { checkShards(); });
+}
+
+void ShardCoordinator::checkShards() {
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (shards[i].pid <= 0) continue;
+        int status = 0;
+        if (waitpid(shards[i].pid, &status, WNOHANG) == shards[i].pid) {
+            shards[i].pid = -1;
+            throw std::runtime_error("Shard " + std::to_string(i) + " exited unexpectedly");
+        }
+    }
+}
+
+void ShardCoordinator::terminateShards() {
+    for (auto& shard : shards) {
+        if (shard.pid <= 0) continue;
+        kill(shard.pid, SIGTERM);
+        waitpid(shard.pid, nullptr, 0);
+        shard.pid = -1;
+    }
+}
+
+void ShardCoordinator::waitShards() {
+    for (size_t i = 0; i < shards.size(); ++i) {
+        int status = 0;
+        if (waitpid(shards[i].pid, &status, 0) < 0) continue;
+        shards[i].pid = -1;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            throw std::runtime_error("Shard " + std::to_string(i) + " failed");
+        }
+    }
+}
+
+void ShardCoordinator::printStatus(double elapsed, uint32_t alive) const {
+    std::cout << "Time: " << std::fixed << std::setprecision(0) << elapsed << "s / " 
+              << config.game_duration << "s  Tick: " << tick << "  Alive: " << alive 
+              << "  Battles: " << total_battles << "  Kills: " << total_kills << std::endl;
+}
+
+void ShardCoordinator::printFinalReport() const {
+    std::cout << "\n\n" << std::string(50, '=') << std::endl;
+    std::cout << "           FINAL REPORT" << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    
+    double seconds = std::chrono::duration<double>(stopped_at - started_at).count();
+    if (config.headless) {
+        std::cout << "Ticks:    " << tick << " in " << std::fixed << std::setprecision(3) 
+                  << seconds << " s (" << std::setprecision(1) 
+                  << (seconds > 0.0 ? tick / seconds : 0.0) << " ticks/s)" << std::endl;
+    } else {
+        std::cout << "Duration: " << static_cast<int>(seconds) << " seconds" << std::endl;
+    }
+    std::cout << "Battles:  " << total_battles << std::endl;
+    std::cout << "Kills:    " << total_kills << std::endl;
+    
+    double throughput = seconds > 0.0 ? total_battles / seconds : 0.0;
+    std::cout << "Shards: " << count << " (" << Transport::kindName(config.shard_transport) << ")"
+              << "  Throughput: " << std::fixed << std::setprecision(1) 
+              << throughput << " battles/s" << std::endl;
+    
+    //       
+    auto toMs = [](uint64_t ns) { return ns / 1e6; };
+    std::cout << "Tick barrier: p50 " << std::setprecision(3) << toMs(tick_latency.percentile(0.5))
+              << " ms  p99 " << toMs(tick_latency.percentile(0.99)) 
+              << " ms  max " << toMs(tick_latency.getMax()) << " ms" << std::endl;
+    
+    //        
+    int width = ShardNode::tileWidth(config.map_width, count);
+    std::cout << "\nShard  Columns      Alive  Busy/tick  Migrated in/out" << std::endl;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        const auto& report = shards[i].final_report;
+        int alive = 0;
+        for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) alive += report.alive_by_kind[kind];
+        int left = static_cast<int>(i) * width;
+        int right = std::min(config.map_width, left + width) - 1;
+        
+        std::cout << std::left << std::setw(7) << i
+                  << std::setw(12) << (std::to_string(left) + "-" + std::to_string(right))
+                  << std::right << std::setw(6) << alive
+                  << std::setw(8) << std::setprecision(3) 
+                  << (tick > 0 ? toMs(shards[i].busy_ns / tick) : 0.0) << " ms"
+                  << "  " << report.migrated_in << "/" << report.migrated_out << std::endl;
+    }
+    
+    std::array<int, NPC_KIND_COUNT> alive_by_kind{};
+    std::array<int, NPC_KIND_COUNT> dead_by_kind{};
+    for (const auto& shard : shards) {
+        for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+            alive_by_kind[kind] += shard.final_report.alive_by_kind[kind];
+            dead_by_kind[kind] += shard.final_report.dead_by_kind[kind];
+        }
+    }
+    int alive_count = 0;
+    int total_count = 0;
+    for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        alive_count += alive_by_kind[kind];
+        total_count += alive_by_kind[kind] + dead_by_kind[kind];
+    }
+    
+    std::cout << "\nSurvivors: " << alive_count << "/" << total_count 
+              << " (" << std::fixed << std::setprecision(1) 
+              << (total_count > 0 ? alive_count * 100.0 / total_count : 0.0) << "%)" << std::endl;
+    std::cout << std::string(30, '-') << std::endl;
+    
+    std::cout << "Type      Alive/Dead  Survival" << std::endl;
+    for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        const char* type = kindName(static_cast<NPCKind>(kind));
+        int alive = alive_by_kind[kind];
+        int dead = dead_by_kind[kind];
+        int total = alive + dead;
+        double rate = total > 0 ? (alive * 100.0 / total) : 0.0;
+        
+        std::cout << std::left << std::setw(8) << type
+                  << std::right << std::setw(4) << alive
+                  << "/" << std::setw(4) << dead
+                  << std::setw(10) << std::fixed << std::setprecision(1) << rate << "%"
+                  << std::endl;
+    }
+    
+    std::cout << std::string(50, '=') << std::endl;
+    std::cout << "\nDetailed logs saved to '" << shardLogPath(config.log_path, 0) << "'";
+    if (count > 1) std::cout << " .. '" << shardLogPath(config.log_path, count - 1) << "'";
+    std::cout << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef SHARD_COORDINATOR_H
+#define SHARD_COORDINATOR_H
+
+#include "../game/game_config.h"
+#include "../utils/latency_histogram.h"
+#include "../utils/stop_signal.h"
+#include "shard_protocol.h"
+#include "transport.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <sys/types.h>
+
+//     (fork),    
+// .   - :   ,   
+//    .    ,
+//    
+class ShardCoordinator {
+public:
+    ShardCoordinator(const GameConfig& config, size_t shards);
+    ~ShardCoordinator();
+
+    ShardCoordinator(const ShardCoordinator&) = delete;
+    ShardCoordinator& operator=(const ShardCoordinator&) = delete;
+
+    // ,      :  fork
+    //       
+    void run();
+
+    //  ;     
+    void stop() { stop_signal.raise(); }
+
+private:
+    struct Shard {
+        pid_t pid = -1;
+        std::unique_ptr<Transport> link;
+        std::vector<uint8_t> command;
+        std::vector<uint8_t> report;
+        ShardFinalReport final_report{};
+        uint64_t busy_ns = 0;   //   
+    };
+
+    GameConfig config;
+    size_t count;
+    std::vector<Shard> shards;
+    StopSignal stop_signal;
+
+    uint32_t tick = 0;
+    uint64_t total_battles = 0;
+    uint64_t total_kills = 0;
+    LatencyHistogram tick_latency;
+    std::chrono::steady_clock::time_point started_at;
+    std::chrono::steady_clock::time_point stopped_at;
+
+    void launch();
+    
+    //        shards[i].report
+    void broadcast(const ShardCommand& command);
+    
+    //      : ,  
+    void checkShards();
+    void terminateShards();
+    void waitShards();
+    
+    void printStatus(double elapsed, uint32_t alive) const;
+    void printFinalReport() const;
+};
+
+#endif
\ No newline at end of file
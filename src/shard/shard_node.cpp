@@ -0,0 +1,257 @@
+#include "shard_node.h"
+#include "../utils/trace.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+
+ShardNode::ShardNode(GameManager& game, size_t index, size_t count, Links links)
+    : game(game), world(game.world), index(index), count(count), links(std::move(links)) {
+    width = tileWidth(game.config.map_width, count);
+    left = static_cast<int>(index) * width;
+    right = std::min(game.config.map_width, left + width);
+    //         
+    grid.configure(right - left + 2 * MAX_KILL_DISTANCE, game.config.map_height, MAX_KILL_DISTANCE);
+}
+
+int ShardNode::tileWidth(int map_width, size_t count) {
+    return (map_width + static_cast<int>(count) - 1) / static_cast<int>(count);
+}
+
+size_t ShardNode::maxShards(int map_width) {
+    int narrowest = std::max(MAX_KILL_DISTANCE, MAX_MOVE_DISTANCE);
+    return static_cast<size_t>(std::max(1, map_width / narrowest));
+}
+
+size_t ShardNode::ownerOf(int x) const {
+    return std::min(count - 1, static_cast<size_t>(x / width));
+}
+
+Transport* ShardNode::neighbour(int side) const {
+    return side == LEFT ? links.left.get() : links.right.get();
+}
+
+void ShardNode::checkCoordinator() const {
+    if (getppid() != links.coordinator_pid) {
+        throw std::runtime_error("Coordinator exited");
+    }
+}
+
+void ShardNode::run() {
+    Trace::setThreadName("shard " + std::to_string(index));
+    game.initialize();
+    
+    for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        initial_dead[kind] = world.stats().dead(static_cast<NPCKind>(kind));
+    }
+    for (uint32_t id = 0; id < world.size(); ++id) {
+        if (world.isAlive(id) && ownerOf(world.x(id)) == index) {
+            owned.push_back(id);
+        }
+    }
+    
+    auto idle = [this]() { checkCoordinator(); };
+    std::vector<uint8_t> message;
+    for (;;) {
+        links.coordinator->receive(message, idle);
+        auto command = shard_protocol::decode<ShardCommand>(message);
+        if (command.stop) break;
+        
+        auto started = std::chrono::steady_clock::now();
+        waited = std::chrono::steady_clock::duration::zero();
+        int battles_before = game.total_battles.load();
+        int kills_before = game.total_kills.load();
+        
+        runTick(command.tick);
+        
+        uint32_t alive = 0;
+        for (uint32_t id : owned) alive += world.isAlive(id) ? 1 : 0;
+        auto busy = std::chrono::steady_clock::now() - started - waited;
+        ShardTickReport report{
+            command.tick,
+            static_cast<uint32_t>(game.total_battles.load() - battles_before),
+            static_cast<uint32_t>(game.total_kills.load() - kills_before),
+            alive,
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count())
+        };
+        shard_protocol::encode(report, message);
+        links.coordinator->send(message, idle);
+    }
+    
+    shard_protocol::encode(finalReport(), message);
+    links.coordinator->send(message, idle);
+}
+
+void ShardNode::runTick(uint32_t tick) {
+    game.tick = tick;
+    {
+        PhaseTimer timer(game.metrics, TickPhase::Move);
+        moveTile(tick);
+    }
+    shareGhosts(tick);
+    
+    //       NPC
+    {
+        PhaseTimer timer(game.metrics, TickPhase::Collision);
+        collideTile(tick);
+    }
+    {
+        PhaseTimer timer(game.metrics, TickPhase::BattleResolve);
+        game.resolveRegionBattles(local_battles);
+    }
+    shareDeaths(tick, ShardPhase::LocalDeaths);
+    
+    //   :   ,   ,  
+    if (index % 2 == 0) {
+        PhaseTimer timer(game.metrics, TickPhase::BattleResolve);
+        game.resolveRegionBattles(cross_battles);
+    }
+    shareDeaths(tick, ShardPhase::EvenDeaths);
+    if (index % 2 == 1) {
+        PhaseTimer timer(game.metrics, TickPhase::BattleResolve);
+        game.resolveRegionBattles(cross_battles);
+    }
+    shareDeaths(tick, ShardPhase::OddDeaths);
+    
+    game.total_battles += static_cast<int>(local_battles.size() + cross_battles.size());
+    game.deliverKills();
+}
+
+void ShardNode::moveTile(uint32_t tick) {
+    for (auto& records : outgoing) records.clear();
+    
+    size_t kept = 0;
+    for (uint32_t id : owned) {
+        if (!world.isAlive(id)) continue; //    
+        
+        game.moveOne(id, tick);
+        int x = world.x(id);
+        size_t owner = ownerOf(x);
+        if (owner == index) {
+            owned[kept++] = id;
+        } else {
+            //   NPC    :   
+            outgoing[owner < index ? LEFT : RIGHT].push_back(ShardRecord{id, x, world.y(id)});
+            migrated_out++;
+        }
+    }
+    owned.resize(kept);
+    
+    exchangeRecords(tick, ShardPhase::Migrants);
+    
+    //   :  ,  ,   
+    for (const auto& records : incoming) {
+        for (const auto& record : records) {
+            world.setPosition(record.id, record.x, record.y);
+            owned.push_back(record.id);
+        }
+        migrated_in += records.size();
+    }
+}
+
+void ShardNode::shareGhosts(uint32_t tick) {
+    //  NPC    :    
+    for (auto& records : outgoing) records.clear();
+    for (uint32_t id : owned) {
+        int x = world.x(id);
+        if (index > 0 && x < left + MAX_KILL_DISTANCE) {
+            outgoing[LEFT].push_back(ShardRecord{id, x, world.y(id)});
+        }
+        if (index + 1 < count && x >= right - MAX_KILL_DISTANCE) {
+            outgoing[RIGHT].push_back(ShardRecord{id, x, world.y(id)});
+        }
+    }
+    for (int side : {LEFT, RIGHT}) {
+        ghosts_sent[side].clear();
+        for (const auto& record : outgoing[side]) ghosts_sent[side].push_back(record.id);
+    }
+    
+    exchangeRecords(tick, ShardPhase::Ghosts);
+    
+    for (int side : {LEFT, RIGHT}) {
+        ghosts_received[side].clear();
+        for (const auto& record : incoming[side]) {
+            world.setPosition(record.id, record.x, record.y);
+            ghosts_received[side].push_back(record.id);
+        }
+    }
+}
+
+void ShardNode::collideTile(uint32_t tick) {
+    //     :      
+    const int origin = left - MAX_KILL_DISTANCE;
+    auto insert = [&](uint32_t id) {
+        int reach = kindKillDistance(world.kind(id));
+        grid.insert(id, world.x(id) - origin, world.y(id), reach * reach);
+    };
+    grid.clear();
+    for (uint32_t id : owned) insert(id);
+    for (const auto& ghosts : ghosts_received) {
+        for (uint32_t id : ghosts) insert(id);
+    }
+    grid.build();
+    
+    game.collideStrip(grid, scratch, index, width, count, tick, local_battles, cross_battles);
+}
+
+void ShardNode::shareDeaths(uint32_t tick, ShardPhase phase) {
+    //       NPC:        
+    for (int side : {LEFT, RIGHT}) {
+        outgoing[side].clear();
+        for (const auto* ids : {&ghosts_sent[side], &ghosts_received[side]}) {
+            for (uint32_t id : *ids) {
+                if (!world.isAlive(id)) outgoing[side].push_back(ShardRecord{id, 0, 0});
+            }
+        }
+    }
+    
+    exchangeRecords(tick, phase);
+    
+    //         
+    for (const auto& records : incoming) {
+        for (const auto& record : records) {
+            if (world.kill(record.id)) {
+                remote_deaths[static_cast<int>(world.kind(record.id))]++;
+            }
+        }
+    }
+}
+
+void ShardNode::exchangeRecords(uint32_t tick, ShardPhase phase) {
+    TRACE_SCOPE("exchange", "shard");
+    auto started = std::chrono::steady_clock::now();
+    
+    for (int side : {LEFT, RIGHT}) {
+        incoming[side].clear();
+        Transport* link = neighbour(side);
+        if (!link) continue;
+        shard_protocol::encodeRecords(tick, phase, outgoing[side], send_buffers[side]);
+        exchange.send(*link, send_buffers[side]);
+        exchange.receive(*link, receive_buffers[side]);
+    }
+    exchange.run([this]() { checkCoordinator(); });
+    
+    for (int side : {LEFT, RIGHT}) {
+        if (neighbour(side)) {
+            shard_protocol::decodeRecords(receive_buffers[side], tick, phase, incoming[side]);
+        }
+    }
+    waited += std::chrono::steady_clock::now() - started;
+}
+
+ShardFinalReport ShardNode::finalReport() const {
+    ShardFinalReport report{};
+    for (uint32_t id : owned) {
+        if (world.isAlive(id)) report.alive_by_kind[static_cast<int>(world.kind(id))]++;
+    }
+    
+    //   ;     (  )  
+    for (int kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        report.dead_by_kind[kind] = world.stats().dead(static_cast<NPCKind>(kind)) 
+                                  - remote_deaths[kind] - (index == 0 ? 0 : initial_dead[kind]);
+    }
+    report.battles = static_cast<uint64_t>(game.total_battles.load());
+    report.kills = static_cast<uint64_t>(game.total_kills.load());
+    report.migrated_in = migrated_in;
+    report.migrated_out = migrated_out;
+    return report;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef SHARD_NODE_H
+#define SHARD_NODE_H
+
+#include "../game/game_manager.h"
+#include "../game/spatial_grid.h"
+#include "shard_protocol.h"
+#include "transport.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <sys/types.h>
+
+//  -:    [left, right).
+//         ,  
+//      NPC;     ,  
+//  :   ,  ()  
+class ShardNode {
+public:
+    struct Links {
+        std::unique_ptr<Transport> coordinator;
+        std::unique_ptr<Transport> left;    //     
+        std::unique_ptr<Transport> right;   //    
+        pid_t coordinator_pid = -1;         // ;     
+    };
+
+    ShardNode(GameManager& game, size_t index, size_t count, Links links);
+
+    //        
+    void run();
+
+    //  :      ,  NPC  
+    //            
+    static int tileWidth(int map_width, size_t count);
+    static size_t maxShards(int map_width);
+
+private:
+    static constexpr int LEFT = 0;
+    static constexpr int RIGHT = 1;
+
+    GameManager& game;
+    World& world;
+    size_t index;
+    size_t count;
+    int width;
+    int left;
+    int right;
+    Links links;
+
+    std::vector<uint32_t> owned;
+
+    //  :        
+    std::array<std::vector<ShardRecord>, 2> outgoing;
+    std::array<std::vector<ShardRecord>, 2> incoming;
+    std::array<std::vector<uint8_t>, 2> send_buffers;
+    std::array<std::vector<uint8_t>, 2> receive_buffers;
+    std::array<std::vector<uint32_t>, 2> ghosts_sent;
+    std::array<std::vector<uint32_t>, 2> ghosts_received;
+    MessageExchange exchange;
+
+    //       
+    SpatialGrid grid;
+    GameManager::CollisionBand scratch;
+    std::vector<BattleTask> local_battles;
+    std::vector<BattleTask> cross_battles;
+
+    //    :     
+    std::array<int, NPC_KIND_COUNT> remote_deaths{};
+    std::array<int, NPC_KIND_COUNT> initial_dead{};
+    uint64_t migrated_in = 0;
+    uint64_t migrated_out = 0;
+    std::chrono::steady_clock::duration waited{0};
+
+    size_t ownerOf(int x) const;
+    Transport* neighbour(int side) const;
+
+    // ,   :     
+    //     ,   
+    void checkCoordinator() const;
+
+    void runTick(uint32_t tick);
+    void moveTile(uint32_t tick);
+    void shareGhosts(uint32_t tick);
+    void collideTile(uint32_t tick);
+    void shareDeaths(uint32_t tick, ShardPhase phase);
+
+    // outgoing[side]  , incoming[side]   
+    void exchangeRecords(uint32_t tick, ShardPhase phase);
+
+    ShardFinalReport finalReport() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+#ifndef SHARD_PROTOCOL_H
+#define SHARD_PROTOCOL_H
+
+#include "../npc/npc_kind.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+//   -  .  
+//       ,   
+//    ,   
+
+// NPC    :      ,
+//            
+struct ShardRecord {
+    uint32_t id;
+    int32_t x;
+    int32_t y;
+};
+
+//    ,  
+enum class ShardPhase : uint32_t {
+    Migrants,       // NPC,    
+    Ghosts,         //   NPC     
+    LocalDeaths,    // ,     
+    EvenDeaths,     //        
+    OddDeaths       //    
+};
+
+//  -> :   tick  
+struct ShardCommand {
+    uint32_t tick;
+    uint32_t stop;
+};
+
+//  ->    
+struct ShardTickReport {
+    uint32_t tick;
+    uint32_t battles;
+    uint32_t kills;
+    uint32_t alive;
+    uint64_t busy_ns;   //      
+};
+
+//  ->    
+struct ShardFinalReport {
+    int32_t alive_by_kind[NPC_KIND_COUNT];
+    int32_t dead_by_kind[NPC_KIND_COUNT];  //   
+    uint64_t battles;
+    uint64_t kills;
+    uint64_t migrated_in;
+    uint64_t migrated_out;
+};
+
+namespace shard_protocol {
+
+template <typename T>
+void encode(const T& value, std::vector<uint8_t>& out) {
+    static_assert(std::is_trivially_copyable<T>::value, "shard messages are copied as bytes");
+    out.resize(sizeof(T));
+    std::memcpy(out.data(), &value, sizeof(T));
+}
+
+template <typename T>
+T decode(const std::vector<uint8_t>& message) {
+    static_assert(std::is_trivially_copyable<T>::value, "shard messages are copied as bytes");
+    if (message.size() != sizeof(T)) {
+        throw std::runtime_error("Malformed shard message");
+    }
+    T value;
+    std::memcpy(&value, message.data(), sizeof(T));
+    return value;
+}
+
+//    :      
+struct RecordsHeader {
+    uint32_t tick;
+    ShardPhase phase;
+    uint32_t count;
+};
+
+inline void encodeRecords(uint32_t tick, ShardPhase phase, const std::vector<ShardRecord>& records,
+                          std::vector<uint8_t>& out) {
+    RecordsHeader header{tick, phase, static_cast<uint32_t>(records.size())};
+    out.resize(sizeof(header) + records.size() * sizeof(ShardRecord));
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!records.empty()) {
+        std::memcpy(out.data() + sizeof(header), records.data(), records.size() * sizeof(ShardRecord));
+    }
+}
+
+inline void decodeRecords(const std::vector<uint8_t>& message, uint32_t tick, ShardPhase phase,
+                          std::vector<ShardRecord>& records) {
+    RecordsHeader header;
+    if (message.size() < sizeof(header)) {
+        throw std::runtime_error("Malformed shard message");
+    }
+    std::memcpy(&header, message.data(), sizeof(header));
+    if (header.tick != tick || header.phase != phase ||
+        message.size() != sizeof(header) + header.count * sizeof(ShardRecord)) {
+        throw std::runtime_error("Shard neighbours are out of step");
+    }
+    records.resize(header.count);
+    if (header.count > 0) {
+        std::memcpy(records.data(), message.data() + sizeof(header), header.count * sizeof(ShardRecord));
+    }
+}
+
+} // namespace shard_protocol
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "shm_transport.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <system_error>
+#include <sys/mman.h>
+
+class ShmTransport::Mapping {
+public:
+    void* base = nullptr;
+    size_t size = 0;
+
+    explicit Mapping(size_t size) : size(size) {
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "Cannot map shard ring");
+        }
+    }
+
+    ~Mapping() {
+        munmap(base, size);
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+};
+
+ShmTransport::ShmTransport(std::shared_ptr<Mapping> mapping, Ring* outgoing, uint8_t* outgoing_data,
+                           Ring* incoming, uint8_t* incoming_data, size_t capacity)
+    : mapping(std::move(mapping)), outgoing(outgoing), outgoing_data(outgoing_data),
+      incoming(incoming), incoming_data(incoming_data), capacity(capacity) {}
+
+std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>> ShmTransport::createPair(size_t capacity) {
+    size_t rounded = CACHE_LINE;
+    while (rounded < capacity) rounded <<= 1;
+    capacity = rounded;
+    
+    // [ A->B][][ B->A][]
+    const size_t half = sizeof(Ring) + capacity;
+    auto mapping = std::make_shared<Mapping>(2 * half);
+    auto* bytes = static_cast<uint8_t*>(mapping->base);
+    Ring* forward = new (bytes) Ring();
+    Ring* backward = new (bytes + half) Ring();
+    uint8_t* forward_data = bytes + sizeof(Ring);
+    uint8_t* backward_data = bytes + half + sizeof(Ring);
+    
+    std::unique_ptr<Transport> first(new ShmTransport(
+        mapping, forward, forward_data, backward, backward_data, capacity));
+    std::unique_ptr<Transport> second(new ShmTransport(
+        mapping, backward, backward_data, forward, forward_data, capacity));
+    return {std::move(first), std::move(second)};
+}
+
+size_t ShmTransport::writeSome(const uint8_t* data, size_t size) {
+    uint64_t head = outgoing->head.load(std::memory_order_relaxed);
+    uint64_t tail = outgoing->tail.load(std::memory_order_acquire);
+    size_t count = std::min<size_t>(size, capacity - static_cast<size_t>(head - tail));
+    if (count == 0) return 0;
+    
+    //      
+    size_t position = static_cast<size_t>(head & (capacity - 1));
+    size_t first = std::min(count, capacity - position);
+    std::memcpy(outgoing_data + position, data, first);
+    std::memcpy(outgoing_data, data + first, count - first);
+    outgoing->head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+size_t ShmTransport::readSome(uint8_t* data, size_t size) {
+    uint64_t tail = incoming->tail.load(std::memory_order_relaxed);
+    uint64_t head = incoming->head.load(std::memory_order_acquire);
+    size_t count = std::min<size_t>(size, static_cast<size_t>(head - tail));
+    if (count == 0) return 0;
+    
+    size_t position = static_cast<size_t>(tail & (capacity - 1));
+    size_t first = std::min(count, capacity - position);
+    std::memcpy(data, incoming_data + position, first);
+    std::memcpy(data + first, incoming_data, count - first);
+    incoming->tail.store(tail + count, std::memory_order_release);
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef SHM_TRANSPORT_H
+#define SHM_TRANSPORT_H
+
+#include "transport.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+//    :        
+//  (   )    MAP_SHARED,
+//     fork.     
+class ShmTransport : public Transport {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+    // capacity     
+    static std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>> createPair(size_t capacity);
+
+    size_t writeSome(const uint8_t* data, size_t size) override;
+    size_t readSome(uint8_t* data, size_t size) override;
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    //      ;  -  
+    struct Ring {
+        alignas(CACHE_LINE) std::atomic<uint64_t> head{0};  //  
+        alignas(CACHE_LINE) std::atomic<uint64_t> tail{0};  //  
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, 
+                  "ring counters must be lock-free to be shared between processes");
+
+    //  ,       
+    class Mapping;
+
+    std::shared_ptr<Mapping> mapping;
+    Ring* outgoing;
+    uint8_t* outgoing_data;
+    Ring* incoming;
+    uint8_t* incoming_data;
+    size_t capacity;
+
+    ShmTransport(std::shared_ptr<Mapping> mapping, Ring* outgoing, uint8_t* outgoing_data,
+                 Ring* incoming, uint8_t* incoming_data, size_t capacity);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "socket_transport.h"
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <sys/socket.h>
+#include <unistd.h>
+
+SocketTransport::SocketTransport(int fd) : fd(fd) {
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE));
+}
+
+SocketTransport::~SocketTransport() {
+    close(fd);
+}
+
+std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>> SocketTransport::createPair() {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot create shard socket pair");
+    }
+    std::unique_ptr<Transport> first(new SocketTransport(fds[0]));
+    std::unique_ptr<Transport> second(new SocketTransport(fds[1]));
+    return {std::move(first), std::move(second)};
+}
+
+size_t SocketTransport::writeSome(const uint8_t* data, size_t size) {
+    // MSG_NOSIGNAL:    ,   SIGPIPE
+    ssize_t written = ::send(fd, data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (written >= 0) return static_cast<size_t>(written);
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+    throw std::system_error(errno, std::generic_category(), "Shard link write failed");
+}
+
+size_t SocketTransport::readSome(uint8_t* data, size_t size) {
+    ssize_t received = ::recv(fd, data, size, MSG_DONTWAIT);
+    if (received > 0) return static_cast<size_t>(received);
+    if (received == 0) throw std::runtime_error("Shard link closed by peer");
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+    throw std::system_error(errno, std::generic_category(), "Shard link read failed");
+}
\ No newline at end of file
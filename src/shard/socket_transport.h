@@ -0,0 +1,33 @@
+#ifndef SOCKET_TRANSPORT_H
+#define SOCKET_TRANSPORT_H
+
+#include "transport.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+//      Unix (socketpair);  
+//      ,     
+class SocketTransport : public Transport {
+public:
+    //   ,       
+    static constexpr int SOCKET_BUFFER_SIZE = 1 << 20;
+
+    static std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>> createPair();
+
+    ~SocketTransport() override;
+
+    SocketTransport(const SocketTransport&) = delete;
+    SocketTransport& operator=(const SocketTransport&) = delete;
+
+    size_t writeSome(const uint8_t* data, size_t size) override;
+    size_t readSome(uint8_t* data, size_t size) override;
+
+private:
+    int fd;
+
+    explicit SocketTransport(int fd);
+};
+
+#endif
\ No newline at end of file
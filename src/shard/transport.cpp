@@ -0,0 +1,132 @@
+#include "transport.h"
+#include "shm_transport.h"
+#include "socket_transport.h"
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+//       
+constexpr uint32_t MAX_MESSAGE_SIZE = 1u << 30;
+
+//     ,  
+constexpr int SPIN_ROUNDS = 64;
+constexpr auto IDLE_SLEEP = std::chrono::microseconds(50);
+
+} // namespace
+
+void Transport::send(const std::vector<uint8_t>& message, const std::function<void()>& idle) {
+    MessageExchange exchange;
+    exchange.send(*this, message);
+    exchange.run(idle);
+}
+
+void Transport::receive(std::vector<uint8_t>& message, const std::function<void()>& idle) {
+    MessageExchange exchange;
+    exchange.receive(*this, message);
+    exchange.run(idle);
+}
+
+std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>> Transport::createPair(Kind kind) {
+    switch (kind) {
+        case Kind::SharedMemory:
+            return ShmTransport::createPair(ShmTransport::DEFAULT_CAPACITY);
+        case Kind::UnixSocket:
+            return SocketTransport::createPair();
+    }
+    throw std::invalid_argument("Unknown transport kind");
+}
+
+const char* Transport::kindName(Kind kind) {
+    switch (kind) {
+        case Kind::SharedMemory: return "shm";
+        case Kind::UnixSocket: return "unix";
+    }
+    return "unknown";
+}
+
+bool Transport::kindFromName(const std::string& name, Kind& kind) {
+    if (name == "shm") {
+        kind = Kind::SharedMemory;
+        return true;
+    }
+    if (name == "unix") {
+        kind = Kind::UnixSocket;
+        return true;
+    }
+    return false;
+}
+
+void MessageExchange::send(Transport& link, const std::vector<uint8_t>& message) {
+    if (message.size() > MAX_MESSAGE_SIZE) {
+        throw std::length_error("Shard message too large");
+    }
+    operations.push_back(Operation{&link, &message, nullptr, 
+                                   static_cast<uint32_t>(message.size()), 0});
+}
+
+void MessageExchange::receive(Transport& link, std::vector<uint8_t>& message) {
+    operations.push_back(Operation{&link, nullptr, &message, 0, 0});
+}
+
+bool MessageExchange::advance(Operation& operation) {
+    bool progress = false;
+    auto* header = reinterpret_cast<uint8_t*>(&operation.length);
+    
+    //  ,  ; ,   
+    for (;;) {
+        size_t moved = 0;
+        if (operation.done < HEADER_SIZE) {
+            size_t left = HEADER_SIZE - operation.done;
+            moved = operation.outgoing 
+                ? operation.link->writeSome(header + operation.done, left)
+                : operation.link->readSome(header + operation.done, left);
+            if (moved == left && operation.incoming) {
+                if (operation.length > MAX_MESSAGE_SIZE) {
+                    throw std::length_error("Shard message too large");
+                }
+                operation.incoming->resize(operation.length);
+            }
+        } else {
+            size_t offset = operation.done - HEADER_SIZE;
+            size_t left = operation.length - offset;
+            if (left == 0) return progress;
+            moved = operation.outgoing
+                ? operation.link->writeSome(operation.outgoing->data() + offset, left)
+                : operation.link->readSome(operation.incoming->data() + offset, left);
+        }
+        if (moved == 0) return progress;
+        operation.done += moved;
+        progress = true;
+    }
+}
+
+void MessageExchange::run(const std::function<void()>& idle) {
+    auto complete = [](const Operation& operation) {
+        return operation.done >= HEADER_SIZE && 
+               operation.done - HEADER_SIZE == operation.length;
+    };
+    
+    int idle_rounds = 0;
+    for (;;) {
+        bool progress = false;
+        bool finished = true;
+        for (auto& operation : operations) {
+            if (complete(operation)) continue;
+            progress |= advance(operation);
+            finished &= complete(operation);
+        }
+        if (finished) break;
+        
+        if (progress) {
+            idle_rounds = 0;
+        } else if (++idle_rounds < SPIN_ROUNDS) {
+            std::this_thread::yield();
+        } else {
+            if (idle) idle();
+            std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+    operations.clear();
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+//      .  - 
+//   ,     MessageExchange
+class Transport {
+public:
+    enum class Kind {
+        SharedMemory,   //    ,  
+        UnixSocket      //    Unix
+    };
+
+    virtual ~Transport() = default;
+
+    //     ; 0 -   .
+    //   - 
+    virtual size_t writeSome(const uint8_t* data, size_t size) = 0;
+    virtual size_t readSome(uint8_t* data, size_t size) = 0;
+
+    //      ; idle -   MessageExchange::run
+    void send(const std::vector<uint8_t>& message, const std::function<void()>& idle = {});
+    void receive(std::vector<uint8_t>& message, const std::function<void()>& idle = {});
+
+    //   ;   fork,   
+    //    
+    static std::pair<std::unique_ptr<Transport>, std::unique_ptr<Transport>> createPair(Kind kind);
+
+    static const char* kindName(Kind kind);
+
+    //  false,   
+    static bool kindFromName(const std::string& name, Kind& kind);
+};
+
+//      .    
+// ,  ,     
+// ,       
+class MessageExchange {
+private:
+    struct Operation {
+        Transport* link;
+        const std::vector<uint8_t>* outgoing;   // nullptr - 
+        std::vector<uint8_t>* incoming;
+        uint32_t length;                        //  
+        size_t done;                            //     
+    };
+    std::vector<Operation> operations;
+
+    static constexpr size_t HEADER_SIZE = sizeof(uint32_t);
+
+    bool advance(Operation& operation);
+
+public:
+    //      run
+    void send(Transport& link, const std::vector<uint8_t>& message);
+    void receive(Transport& link, std::vector<uint8_t>& message);
+
+    //    ; idle , 
+    //      (,  ,   )
+    void run(const std::function<void()>& idle = {});
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+//       (std::barrier
+//    C++20): ,     wait, 
+//       wait
+class Barrier {
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    size_t participants;
+    size_t waiting = 0;
+    uint64_t generation = 0;
+
+public:
+    explicit Barrier(size_t participants) : participants(participants) {}
+
+    Barrier(const Barrier&) = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        uint64_t arrived_in = generation;
+        if (++waiting == participants) {
+            //       
+            waiting = 0;
+            generation++;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [this, arrived_in]() { return generation != arrived_in; });
+    }
+};
+
+#endif
\ No newline at end of file
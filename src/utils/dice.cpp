@@ -1,18 +1,14 @@
 #include "dice.h"
-
-std::random_device Dice::rd;
-std::mt19937 Dice::gen(Dice::rd());
+#include <utility>
 
 int Dice::roll(int sides) {
     if (sides <= 0) return 0;
-    std::uniform_int_distribution<> dist(1, sides);
-    return dist(gen);
+    return Random::getInt(1, sides);
 }
 
 int Dice::rollRange(int min, int max) {
     if (min > max) std::swap(min, max);
-    std::uniform_int_distribution<> dist(min, max);
-    return dist(gen);
+    return Random::getInt(min, max);
 }
 
 int Dice::rollMultiple(int count, int sides) {
@@ -25,4 +21,10 @@ int Dice::rollMultiple(int count, int sides) {
 
 int Dice::rollWithModifier(int sides, int modifier) {
     return roll(sides) + modifier;
+}
+
+int Dice::rollKeyed(int sides, uint32_t tick, uint32_t id, 
+                    RandomPurpose purpose, uint32_t sub) {
+    if (sides <= 0) return 0;
+    return Random::keyedInt(1, sides, tick, id, purpose, sub);
 }
\ No newline at end of file
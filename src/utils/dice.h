@@ -1,13 +1,10 @@
 #ifndef DICE_H
 #define DICE_H
 
-#include <random>
+#include "random.h"
+#include <cstdint>
 
 class Dice {
-private:
-    static std::random_device rd;
-    static std::mt19937 gen;
-    
 public:
     //      
     static int roll(int sides = 6);
@@ -20,6 +17,10 @@ public:
     
     //    
     static int rollWithModifier(int sides, int modifier);
+    
+    // ,    (tick, id, )
+    static int rollKeyed(int sides, uint32_t tick, uint32_t id, 
+                         RandomPurpose purpose, uint32_t sub = 0);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "job_system.h"
+#include "trace.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace {
+
+//     ,     
+thread_local const JobSystem* current_system = nullptr;
+thread_local int current_index = -1;
+
+} // namespace
+
+JobSystem::JobSystem(int count) {
+    if (count <= 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    count = std::max(1, count);
+    
+    queues.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        queues.push_back(std::make_unique<Worker>());
+    }
+    workers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        wake.notify_all();
+    }
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void JobSystem::submit(Job job) {
+    size_t index;
+    if (current_system == this) {
+        index = static_cast<size_t>(current_index);
+    } else {
+        index = next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(std::move(job));
+    }
+    
+    //     workerLoop:    ,
+    //         
+    queued.fetch_add(1);
+    if (sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        wake.notify_one();
+    }
+}
+
+bool JobSystem::popLocal(int index, Job& job) {
+    Worker& worker = *queues[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.jobs.empty()) return false;
+    job = std::move(worker.jobs.back());
+    worker.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(int thief, Job& job) {
+    size_t count = queues.size();
+    size_t start = thief >= 0 ? static_cast<size_t>(thief) + 1 : 0;
+    
+    auto take = [&](Worker& worker) {
+        if (worker.jobs.empty()) return false;
+        job = std::move(worker.jobs.front());
+        worker.jobs.pop_front();
+        if (thief >= 0) stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
+    
+    Worker* contended = nullptr;
+    for (size_t offset = 0; offset < count; ++offset) {
+        size_t victim = (start + offset) % count;
+        if (static_cast<int>(victim) == thief) continue;
+        
+        Worker& worker = *queues[victim];
+        std::unique_lock<std::mutex> lock(worker.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            contended = &worker;
+            continue;
+        }
+        if (take(worker)) return true;
+    }
+    
+    //       :    ,
+    //    -         
+    if (contended) {
+        std::lock_guard<std::mutex> lock(contended->mutex);
+        return take(*contended);
+    }
+    return false;
+}
+
+bool JobSystem::runOne() {
+    Job job;
+    bool found = current_system == this 
+        ? popLocal(current_index, job) || steal(current_index, job)
+        : steal(-1, job);
+    if (!found) return false;
+    
+    queued.fetch_sub(1);
+    job();
+    return true;
+}
+
+void JobSystem::workerLoop(int index) {
+    current_system = this;
+    current_index = index;
+    Trace::setThreadName("job worker " + std::to_string(index));
+    
+    for (;;) {
+        Job job;
+        if (popLocal(index, job) || steal(index, job)) {
+            queued.fetch_sub(1);
+            job();
+            continue;
+        }
+        
+        //  ,      -   :
+        //   ,   
+        if (queued.load() > 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleeping.fetch_add(1);
+        wake.wait(lock, [this]() { return stopping.load() || queued.load() > 0; });
+        sleeping.fetch_sub(1);
+        
+        if (stopping.load() && queued.load() == 0) break;
+    }
+}
+
+JobGraph::NodeId JobGraph::add(const char* name, std::function<void()> body) {
+    return addParallel(name, nullptr, [body = std::move(body)](size_t) { body(); });
+}
+
+JobGraph::NodeId JobGraph::addParallel(const char* name, std::function<size_t()> parts,
+                                       std::function<void(size_t part)> body) {
+    auto node = std::make_unique<Node>();
+    node->name = name;
+    node->parts = std::move(parts);
+    node->body = std::move(body);
+    nodes.push_back(std::move(node));
+    return nodes.size() - 1;
+}
+
+void JobGraph::precede(NodeId before, NodeId after) {
+    nodes[before]->successors.push_back(after);
+    nodes[after]->predecessors++;
+}
+
+void JobGraph::run(JobSystem& jobs) {
+    if (nodes.empty()) return;
+    
+    remaining.store(nodes.size());
+    for (auto& node : nodes) {
+        node->pending_inputs.store(node->predecessors);
+    }
+    for (NodeId id = 0; id < nodes.size(); ++id) {
+        if (nodes[id]->predecessors == 0) launch(jobs, id);
+    }
+    
+    //   , ;   ,  
+    while (remaining.load() > 0) {
+        if (jobs.runOne()) continue;
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done.wait(lock, [this]() { return remaining.load() == 0; });
+    }
+}
+
+std::chrono::steady_clock::duration JobGraph::duration(NodeId node) const {
+    return nodes[node]->finished - nodes[node]->started;
+}
+
+void JobGraph::launch(JobSystem& jobs, NodeId id) {
+    Node& node = *nodes[id];
+    node.started = std::chrono::steady_clock::now();
+    
+    size_t count = node.parts ? node.parts() : 1;
+    if (count == 0) {
+        complete(jobs, id);
+        return;
+    }
+    
+    node.pending_parts.store(count);
+    for (size_t part = 0; part < count; ++part) {
+        jobs.submit([this, &jobs, id, part]() { runPart(jobs, id, part); });
+    }
+}
+
+void JobGraph::runPart(JobSystem& jobs, NodeId id, size_t part) {
+    Node& node = *nodes[id];
+    {
+        TRACE_SCOPE(node.name, "job");
+        node.body(part);
+    }
+    if (node.pending_parts.fetch_sub(1) == 1) {
+        complete(jobs, id);
+    }
+}
+
+void JobGraph::complete(JobSystem& jobs, NodeId id) {
+    Node& node = *nodes[id];
+    node.finished = std::chrono::steady_clock::now();
+    
+    //    ,   ,
+    //  run()     
+    for (NodeId next : node.successors) {
+        if (nodes[next]->pending_inputs.fetch_sub(1) == 1) {
+            launch(jobs, next);
+        }
+    }
+    
+    if (remaining.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        done.notify_all();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//     :     ,
+//       (  ),  ,
+//        
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // 0 -   
+    explicit JobSystem(int workers = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    //  ;    -   ,  -  
+    void submit(Job job);
+
+    //      ,   
+    bool runOne();
+
+    int workerCount() const { return static_cast<int>(workers.size()); }
+
+    //       
+    uint64_t getStolen() const { return stolen.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<Worker>> queues;
+    std::vector<std::thread> workers;
+
+    // , ,    ;    ,  
+    std::atomic<size_t> queued{0};
+    std::atomic<int> sleeping{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<size_t> next_queue{0};
+    std::atomic<uint64_t> stolen{0};
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+
+    void workerLoop(int index);
+    bool popLocal(int index, Job& job);
+    bool steal(int thief, Job& job);
+};
+
+//  ,     (   ):
+//  ,     ; 
+//      ,     
+class JobGraph {
+public:
+    using NodeId = size_t;
+
+    //    
+    NodeId add(const char* name, std::function<void()> body);
+
+    //   ;      ,
+    //       
+    NodeId addParallel(const char* name, std::function<size_t()> parts,
+                       std::function<void(size_t part)> body);
+
+    // after    before
+    void precede(NodeId before, NodeId after);
+
+    //     ;    
+    void run(JobSystem& jobs);
+
+    //     :      
+    std::chrono::steady_clock::duration duration(NodeId node) const;
+
+private:
+    struct Node {
+        const char* name;
+        std::function<size_t()> parts;              //  -  
+        std::function<void(size_t)> body;
+        std::vector<NodeId> successors;
+        int predecessors = 0;
+
+        std::atomic<int> pending_inputs{0};
+        std::atomic<size_t> pending_parts{0};
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point finished;
+    };
+
+    std::vector<std::unique_ptr<Node>> nodes;
+
+    std::atomic<size_t> remaining{0};
+    std::mutex done_mutex;
+    std::condition_variable done;
+
+    void launch(JobSystem& jobs, NodeId id);
+    void runPart(JobSystem& jobs, NodeId id, size_t part);
+    void complete(JobSystem& jobs, NodeId id);
+};
+
+#endif
\ No newline at end of file
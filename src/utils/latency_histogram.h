@@ -0,0 +1,83 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+//      - 
+// (  HdrHistogram):      16 
+// ,       1/16.
+//  -     
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr uint64_t SUB_BUCKETS = 1u << SUB_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    void record(uint64_t value) {
+        counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+        
+        uint64_t current = maximum.load(std::memory_order_relaxed);
+        while (value > current && 
+               !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t getSum() const { return sum.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return maximum.load(std::memory_order_relaxed); }
+
+    //   ,     q (0..1)
+    uint64_t percentile(double q) const {
+        uint64_t samples = count();
+        if (samples == 0) return 0;
+        
+        uint64_t rank = static_cast<uint64_t>(q * samples);
+        if (rank >= samples) rank = samples - 1;
+        
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i].load(std::memory_order_relaxed);
+            if (seen > rank) {
+                uint64_t upper = bucketUpper(i);
+                uint64_t max_value = getMax();
+                return upper < max_value ? upper : max_value;
+            }
+        }
+        return getMax();
+    }
+
+    void reset() {
+        for (auto& bucket : counts) bucket.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        maximum.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> maximum{0};
+
+    //   ,  -    4   
+    static size_t bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - SUB_BITS;
+        size_t group = static_cast<size_t>(shift + 1);
+        return group * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    static uint64_t bucketUpper(size_t index) {
+        if (index < SUB_BUCKETS) return index;
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        uint64_t sub = index % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+    }
+};
+
+#endif
\ No newline at end of file
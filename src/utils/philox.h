@@ -0,0 +1,42 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <cstdint>
+
+//   Philox4x32-10 (Salmon et al., 2011):
+//       ,   
+//         
+class Philox4x32 {
+public:
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static Counter generate(Counter counter, Key key) {
+        for (int round = 0; round < ROUNDS; ++round) {
+            counter = singleRound(counter, key);
+            key[0] += WEYL_0;
+            key[1] += WEYL_1;
+        }
+        return counter;
+    }
+
+private:
+    static constexpr int ROUNDS = 10;
+    static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53u;
+    static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57u;
+    static constexpr uint32_t WEYL_0 = 0x9E3779B9u;
+    static constexpr uint32_t WEYL_1 = 0xBB67AE85u;
+
+    static Counter singleRound(const Counter& c, const Key& key) {
+        uint64_t product_0 = static_cast<uint64_t>(MULTIPLIER_0) * c[0];
+        uint64_t product_1 = static_cast<uint64_t>(MULTIPLIER_1) * c[2];
+        uint32_t hi_0 = static_cast<uint32_t>(product_0 >> 32);
+        uint32_t lo_0 = static_cast<uint32_t>(product_0);
+        uint32_t hi_1 = static_cast<uint32_t>(product_1 >> 32);
+        uint32_t lo_1 = static_cast<uint32_t>(product_1);
+        return {hi_1 ^ c[1] ^ key[0], lo_1, hi_0 ^ c[3] ^ key[1], lo_0};
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include "proximity_kernel.h"
+#include <atomic>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__)
+#define PROXIMITY_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using SquaredFn = void (*)(int, int, const int*, const int*, size_t, int*);
+using CollectFn = size_t (*)(int, int, int, const int*, const int*, const int*,
+                             size_t, uint32_t*, int*);
+
+struct Kernels {
+    SimdLevel level;
+    SquaredFn squared;
+    CollectFn collect;
+};
+
+void squaredScalar(int x, int y, const int* xs, const int* ys, size_t count, int* out) {
+    for (size_t i = 0; i < count; ++i) {
+        int dx = xs[i] - x;
+        int dy = ys[i] - y;
+        out[i] = dx * dx + dy * dy;
+    }
+}
+
+//   [begin, count),     
+size_t collectRange(int x, int y, int reach_sq, const int* xs, const int* ys,
+                    const int* reaches_sq, size_t begin, size_t count,
+                    uint32_t* hits, int* dist_sq) {
+    //   :  ,   ;
+    // found   i,      
+    size_t found = 0;
+    for (size_t i = begin; i < count; ++i) {
+        int dx = xs[i] - x;
+        int dy = ys[i] - y;
+        int d2 = dx * dx + dy * dy;
+        hits[found] = static_cast<uint32_t>(i);
+        dist_sq[found] = d2;
+        found += (d2 <= reach_sq) | (d2 <= reaches_sq[i]);
+    }
+    return found;
+}
+
+size_t collectScalar(int x, int y, int reach_sq, const int* xs, const int* ys,
+                     const int* reaches_sq, size_t count, uint32_t* hits, int* dist_sq) {
+    return collectRange(x, y, reach_sq, xs, ys, reaches_sq, 0, count, hits, dist_sq);
+}
+
+#ifdef PROXIMITY_X86
+
+//    ;    
+// ,      
+inline size_t compactLanes(unsigned hit, size_t lanes_used, size_t base, const int* lanes,
+                           uint32_t* hits, int* dist_sq, size_t found) {
+    for (size_t lane = 0; lane < lanes_used; ++lane) {
+        hits[found] = static_cast<uint32_t>(base + lane);
+        dist_sq[found] = lanes[lane];
+        found += (hit >> lane) & 1u;
+    }
+    return found;
+}
+
+// dx  dy    32-    int16,
+//  madd_epi16     dx*dx + dy*dy
+
+inline __m128i squared4(__m128i px, __m128i py, const int* xs, const int* ys) {
+    __m128i dx = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs)), px);
+    __m128i dy = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys)), py);
+    __m128i packed = _mm_or_si128(_mm_slli_epi32(dy, 16), _mm_and_si128(dx, _mm_set1_epi32(0xFFFF)));
+    return _mm_madd_epi16(packed, packed);
+}
+
+void squaredSse2(int x, int y, const int* xs, const int* ys, size_t count, int* out) {
+    const __m128i px = _mm_set1_epi32(x);
+    const __m128i py = _mm_set1_epi32(y);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), squared4(px, py, xs + i, ys + i));
+    }
+    squaredScalar(x, y, xs + i, ys + i, count - i, out + i);
+}
+
+size_t collectSse2(int x, int y, int reach_sq, const int* xs, const int* ys,
+                   const int* reaches_sq, size_t count, uint32_t* hits, int* dist_sq) {
+    const __m128i px = _mm_set1_epi32(x);
+    const __m128i py = _mm_set1_epi32(y);
+    const __m128i own = _mm_set1_epi32(reach_sq);
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i d2 = squared4(px, py, xs + i, ys + i);
+        __m128i theirs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(reaches_sq + i));
+        // ,      
+        __m128i miss = _mm_and_si128(_mm_cmpgt_epi32(d2, own), _mm_cmpgt_epi32(d2, theirs));
+        unsigned hit = ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(miss))) & 0xFu;
+        if (hit == 0) continue;
+
+        alignas(16) int lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), d2);
+        found = compactLanes(hit, 4, i, lanes, hits, dist_sq, found);
+    }
+    return found + collectRange(x, y, reach_sq, xs, ys, reaches_sq, i, count,
+                                hits + found, dist_sq + found);
+}
+
+//     :    
+//     ,  4   
+struct LeftPackTable {
+    uint32_t entries[256];
+
+    constexpr LeftPackTable() : entries() {
+        for (unsigned mask = 0; mask < 256; ++mask) {
+            uint32_t packed = 0;
+            unsigned slot = 0;
+            for (unsigned lane = 0; lane < 8; ++lane) {
+                if (mask & (1u << lane)) {
+                    packed |= lane << (4 * slot);
+                    ++slot;
+                }
+            }
+            entries[mask] = packed;
+        }
+    }
+};
+
+constexpr LeftPackTable LEFT_PACK;
+
+__attribute__((target("avx2")))
+inline __m256i squared8(__m256i px, __m256i py, __m256i xs, __m256i ys) {
+    __m256i dx = _mm256_sub_epi32(xs, px);
+    __m256i dy = _mm256_sub_epi32(ys, py);
+    __m256i packed = _mm256_or_si256(_mm256_slli_epi32(dy, 16), 
+                                     _mm256_and_si256(dx, _mm256_set1_epi32(0xFFFF)));
+    return _mm256_madd_epi16(packed, packed);
+}
+
+__attribute__((target("avx2")))
+void squaredAvx2(int x, int y, const int* xs, const int* ys, size_t count, int* out) {
+    const __m256i px = _mm256_set1_epi32(x);
+    const __m256i py = _mm256_set1_epi32(y);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i d2 = squared8(px, py, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i)),
+                              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), d2);
+    }
+    squaredScalar(x, y, xs + i, ys + i, count - i, out + i);
+}
+
+__attribute__((target("avx2")))
+size_t collectAvx2(int x, int y, int reach_sq, const int* xs, const int* ys,
+                   const int* reaches_sq, size_t count, uint32_t* hits, int* dist_sq) {
+    const __m256i px = _mm256_set1_epi32(x);
+    const __m256i py = _mm256_set1_epi32(y);
+    const __m256i own = _mm256_set1_epi32(reach_sq);
+    const __m256i lane_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i lane_shift = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    size_t found = 0;
+
+    //      ,   
+    //   :     
+    for (size_t i = 0; i < count; i += 8) {
+        size_t remaining = count - i;
+        __m256i xv, yv, theirs;
+        unsigned valid = 0xFFu;
+        if (remaining >= 8) {
+            xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i));
+            yv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i));
+            theirs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(reaches_sq + i));
+        } else {
+            __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(remaining)), lane_index);
+            xv = _mm256_maskload_epi32(xs + i, mask);
+            yv = _mm256_maskload_epi32(ys + i, mask);
+            theirs = _mm256_maskload_epi32(reaches_sq + i, mask);
+            valid = (1u << remaining) - 1;
+        }
+
+        __m256i d2 = squared8(px, py, xv, yv);
+        __m256i miss = _mm256_and_si256(_mm256_cmpgt_epi32(d2, own), _mm256_cmpgt_epi32(d2, theirs));
+        unsigned hit = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(miss))) & valid;
+        if (hit == 0) continue;
+
+        if (remaining >= 8) {
+            //  :      ;
+            // found   i,      
+            __m256i perm = _mm256_and_si256(
+                _mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(LEFT_PACK.entries[hit])), lane_shift),
+                _mm256_set1_epi32(7));
+            __m256i index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), lane_index);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(hits + found),
+                                _mm256_permutevar8x32_epi32(index, perm));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dist_sq + found),
+                                _mm256_permutevar8x32_epi32(d2, perm));
+            found += static_cast<size_t>(__builtin_popcount(hit));
+            continue;
+        }
+
+        alignas(32) int lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), d2);
+        found = compactLanes(hit, remaining, i, lanes, hits, dist_sq, found);
+    }
+    return found;
+}
+
+#endif
+
+const Kernels SCALAR_KERNELS{SimdLevel::Scalar, squaredScalar, collectScalar};
+#ifdef PROXIMITY_X86
+const Kernels SSE2_KERNELS{SimdLevel::SSE2, squaredSse2, collectSse2};
+const Kernels AVX2_KERNELS{SimdLevel::AVX2, squaredAvx2, collectAvx2};
+#endif
+
+const Kernels* kernelsFor(SimdLevel level) {
+#ifdef PROXIMITY_X86
+    if (level == SimdLevel::AVX2) return &AVX2_KERNELS;
+    if (level == SimdLevel::SSE2) return &SSE2_KERNELS;
+#endif
+    (void)level;
+    return &SCALAR_KERNELS;
+}
+
+//        
+std::atomic<const Kernels*>& activeKernels() {
+    static std::atomic<const Kernels*> active{kernelsFor(ProximityKernel::detectLevel())};
+    return active;
+}
+
+} // namespace
+
+void ProximityKernel::squaredDistances(int x, int y, const int* xs, const int* ys,
+                                       size_t count, int* out) {
+    activeKernels().load(std::memory_order_relaxed)->squared(x, y, xs, ys, count, out);
+}
+
+size_t ProximityKernel::collectInReach(int x, int y, int reach_sq,
+                                       const int* xs, const int* ys, const int* reaches_sq,
+                                       size_t count, uint32_t* hits, int* dist_sq) {
+    return activeKernels().load(std::memory_order_relaxed)
+        ->collect(x, y, reach_sq, xs, ys, reaches_sq, count, hits, dist_sq);
+}
+
+SimdLevel ProximityKernel::detectLevel() {
+#ifdef PROXIMITY_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel ProximityKernel::level() {
+    return activeKernels().load(std::memory_order_relaxed)->level;
+}
+
+SimdLevel ProximityKernel::setLevel(SimdLevel level) {
+    SimdLevel supported = detectLevel();
+    if (static_cast<int>(level) > static_cast<int>(supported)) {
+        level = supported;
+    }
+    activeKernels().store(kernelsFor(level), std::memory_order_relaxed);
+    return level;
+}
+
+const char* ProximityKernel::levelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+    }
+    return "unknown";
+}
\ No newline at end of file
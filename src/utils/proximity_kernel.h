@@ -0,0 +1,44 @@
+#ifndef PROXIMITY_KERNEL_H
+#define PROXIMITY_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+//     
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+//   :     
+//    ( xs/ys)     .
+//      int16 (  
+//  ),       int
+class ProximityKernel {
+public:
+    // out[i] =    (x, y)  (xs[i], ys[i])
+    static void squaredDistances(int x, int y, const int* xs, const int* ys,
+                                 size_t count, int* out);
+
+    //  ,   d^2 <= reach_sq  d^2 <= reaches_sq[i];
+    //  hits   ,  dist_sq  ,
+    //     count .   
+    static size_t collectInReach(int x, int y, int reach_sq,
+                                 const int* xs, const int* ys, const int* reaches_sq,
+                                 size_t count, uint32_t* hits, int* dist_sq);
+
+    //  ,   
+    static SimdLevel detectLevel();
+
+    //   (  detectLevel)
+    static SimdLevel level();
+
+    //   (   ); 
+    //     ,  
+    static SimdLevel setLevel(SimdLevel level);
+
+    static const char* levelName(SimdLevel level);
+};
+
+#endif
\ No newline at end of file
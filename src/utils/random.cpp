@@ -1,19 +1,62 @@
 #include "random.h"
+#include "philox.h"
+#include <utility>
 
-std::random_device Random::rd;
-std::mt19937 Random::gen(Random::rd());
+std::atomic<uint64_t> Random::seed{0};
+std::atomic<uint32_t> Random::next_stream{0};
+
+void Random::setSeed(uint64_t new_seed) {
+    seed.store(new_seed);
+}
+
+uint64_t Random::getSeed() {
+    return seed.load();
+}
+
+std::array<uint32_t, 4> Random::block(uint32_t tick, uint32_t id, 
+                                      RandomPurpose purpose, uint32_t sub) {
+    uint64_t key = seed.load(std::memory_order_relaxed);
+    return Philox4x32::generate({tick, id, static_cast<uint32_t>(purpose), sub},
+                                {static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)});
+}
+
+int Random::toRange(uint32_t word, int min, int max) {
+    if (min > max) std::swap(min, max);
+    //       : 
+    //   range / 2^32,    
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    return static_cast<int>(min + static_cast<int64_t>((word * range) >> 32));
+}
+
+int Random::keyedInt(int min, int max, uint32_t tick, uint32_t id, 
+                     RandomPurpose purpose, uint32_t sub) {
+    return toRange(block(tick, id, purpose, sub)[0], min, max);
+}
+
+uint32_t Random::next() {
+    //          
+    thread_local uint32_t stream = next_stream.fetch_add(1);
+    thread_local uint64_t counter = 0;
+    thread_local std::array<uint32_t, 4> buffer{};
+    thread_local int used = 4;
+    
+    if (used == 4) {
+        buffer = block(static_cast<uint32_t>(counter), stream, RandomPurpose::Stream, 
+                       static_cast<uint32_t>(counter >> 32));
+        counter++;
+        used = 0;
+    }
+    return buffer[used++];
+}
 
 int Random::getInt(int min, int max) {
-    std::uniform_int_distribution<> dist(min, max);
-    return dist(gen);
+    return toRange(next(), min, max);
 }
 
 double Random::getDouble(double min, double max) {
-    std::uniform_real_distribution<> dist(min, max);
-    return dist(gen);
+    return min + (max - min) * (next() / 4294967296.0);
 }
 
 bool Random::getBool(double probability) {
-    std::bernoulli_distribution dist(probability);
-    return dist(gen);
+    return next() / 4294967296.0 < probability;
 }
\ No newline at end of file
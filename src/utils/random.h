@@ -1,14 +1,46 @@
 #ifndef RANDOM_H
 #define RANDOM_H
 
-#include <random>
+#include <array>
+#include <atomic>
+#include <cstdint>
 
+//   ,    
+enum class RandomPurpose : uint32_t {
+    SpawnKind = 1,
+    SpawnPosition = 2,
+    Move = 3,
+    Attack = 4,
+    Defense = 5,
+    Stream = 6
+};
+
+//         
+//    (tick, id NPC, ),  
+//          
 class Random {
 private:
-    static std::random_device rd;
-    static std::mt19937 gen;
+    static std::atomic<uint64_t> seed;
+    static std::atomic<uint32_t> next_stream;
     
 public:
+    //     (  )
+    static void setSeed(uint64_t new_seed);
+    static uint64_t getSeed();
+    
+    //     
+    static std::array<uint32_t, 4> block(uint32_t tick, uint32_t id, 
+                                         RandomPurpose purpose, uint32_t sub = 0);
+    
+    //    [min, max]   
+    static int toRange(uint32_t word, int min, int max);
+    
+    static int keyedInt(int min, int max, uint32_t tick, uint32_t id, 
+                        RandomPurpose purpose, uint32_t sub = 0);
+    
+    //       
+    static uint32_t next();
+    
     static int getInt(int min, int max);
     static double getDouble(double min, double max);
     static bool getBool(double probability = 0.5);
@@ -0,0 +1,27 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+
+//      (std::span    C++20)
+template <typename T>
+class Span {
+private:
+    const T* first = nullptr;
+    size_t count = 0;
+
+public:
+    Span() = default;
+    Span(const T* data, size_t size) : first(data), count(size) {}
+    Span(const std::vector<T>& values) : first(values.data()), count(values.size()) {}
+
+    const T* begin() const { return first; }
+    const T* end() const { return first + count; }
+    const T* data() const { return first; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t index) const { return first[index]; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef STOP_SIGNAL_H
+#define STOP_SIGNAL_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+//  ,     .   
+//      (   write  eventfd
+//  ).  eventfd  ,  
+//   ,    
+class StopSignal {
+private:
+    int fd;
+    std::atomic<bool> raised{false};
+    static_assert(std::atomic<bool>::is_always_lock_free, "raise() must be async-signal-safe");
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+    StopSignal() : fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot create stop eventfd");
+        }
+    }
+
+    ~StopSignal() { close(fd); }
+
+    StopSignal(const StopSignal&) = delete;
+    StopSignal& operator=(const StopSignal&) = delete;
+
+    void raise() {
+        raised.store(true, std::memory_order_release);
+        uint64_t one = 1;
+        ssize_t written = write(fd, &one, sizeof(one));
+        (void)written;  //   - ,    
+    }
+
+    //   ;       
+    void reset() {
+        raised.store(false, std::memory_order_release);
+        uint64_t value;
+        ssize_t received = read(fd, &value, sizeof(value));
+        (void)received;
+    }
+
+    bool isRaised() const { return raised.load(std::memory_order_acquire); }
+
+    // true - , false -  
+    bool waitUntil(Clock::time_point deadline) const {
+        while (!isRaised()) {
+            auto left = deadline - Clock::now();
+            if (left <= Clock::duration::zero()) return false;
+            
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(left);
+            auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(left - seconds);
+            timespec timeout{static_cast<time_t>(seconds.count()), static_cast<long>(nanoseconds.count())};
+            pollfd waiter{fd, POLLIN, 0};
+            ppoll(&waiter, 1, &timeout, nullptr);
+        }
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool waitFor(std::chrono::duration<Rep, Period> timeout) const {
+        return waitUntil(Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout));
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "trace.h"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    int64_t begin_ns;
+    int64_t duration_ns;
+};
+
+//   :   ,  dump  
+struct ThreadBuffer {
+    uint32_t tid;
+    std::string name;
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> written{0};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    size_t events_per_thread = Trace::DEFAULT_EVENTS_PER_THREAD;
+    Trace::Clock::time_point origin = Trace::Clock::now();
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+//     ,  dump    
+thread_local ThreadBuffer* current_buffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!current_buffer) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->tid = static_cast<uint32_t>(reg.buffers.size() + 1);
+        buffer->name = "thread-" + std::to_string(buffer->tid);
+        buffer->events.resize(reg.events_per_thread);
+        current_buffer = buffer.get();
+        reg.buffers.push_back(std::move(buffer));
+    }
+    return *current_buffer;
+}
+
+void writeEscaped(std::ostream& out, const std::string& text) {
+    for (char c : text) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+}
+
+} // namespace
+
+std::atomic<bool> Trace::active{false};
+
+void Trace::enable(size_t events_per_thread) {
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.events_per_thread = events_per_thread > 0 ? events_per_thread : 1;
+        reg.origin = Clock::now();
+    }
+    active.store(true, std::memory_order_relaxed);
+}
+
+void Trace::disable() {
+    active.store(false, std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(const std::string& name) {
+    if (!enabled()) return;
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+void Trace::complete(const char* name, const char* category, 
+                     Clock::time_point begin, Clock::time_point end) {
+    ThreadBuffer& buffer = threadBuffer();
+    
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer.events[index % buffer.events.size()];
+    event.name = name;
+    event.category = category;
+    event.begin_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        begin - registry().origin).count();
+    event.duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Trace::dump(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) out << ",\n";
+        first = false;
+    };
+    
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    
+    for (const auto& buffer : reg.buffers) {
+        separator();
+        out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"";
+        writeEscaped(out, buffer->name);
+        out << "\"}}";
+        
+        //    events.size() ,    
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t capacity = buffer->events.size();
+        uint64_t begin = written > capacity ? written - capacity : 0;
+        for (uint64_t i = begin; i < written; ++i) {
+            const TraceEvent& event = buffer->events[i % capacity];
+            separator();
+            out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                << "\",\"ts\":" << event.begin_ns / 1000.0
+                << ",\"dur\":" << event.duration_ns / 1000.0 << "}";
+        }
+    }
+    
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
\ No newline at end of file
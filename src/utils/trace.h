@@ -0,0 +1,66 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+//    Chrome trace_event (  Perfetto).
+//        ,  
+//    .   
+//     
+class Trace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 1 << 16;
+
+    //  ;   ,    
+    static void enable(size_t events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+    static void disable();
+
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    //     
+    static void setThreadName(const std::string& name);
+
+    //    begin  end;    - 
+    static void complete(const char* name, const char* category, 
+                         Clock::time_point begin, Clock::time_point end);
+
+    //     JSON; ,   
+    static bool dump(const std::string& path);
+
+private:
+    static std::atomic<bool> active;
+};
+
+//  :      
+class TraceScope {
+private:
+    const char* name;
+    const char* category;
+    Trace::Clock::time_point begin;
+    bool recording;
+
+public:
+    TraceScope(const char* name, const char* category)
+        : name(name), category(category), recording(Trace::enabled()) {
+        if (recording) begin = Trace::Clock::now();
+    }
+
+    ~TraceScope() {
+        if (recording) Trace::complete(name, category, begin, Trace::Clock::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name, category)
+
+#endif
\ No newline at end of file